@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/dense_deterministic_automaton.h>
+#include <cppformlang/finite_automata/nondeterministic_finite_automaton.h>
+#include <generators.h>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// args: n, width, the blow-up automaton over `width` byte symbols where every symbol but 'a' acts as 'b'
+NondeterministicFiniteAutomaton WideBlowUp(benchmark::State& state) {
+  const auto n = static_cast<State>(state.range(0));
+  const auto width = static_cast<Symbol>(state.range(1));
+  NondeterministicFiniteAutomaton nfa;
+  for (Symbol symbol = 0; symbol != width; ++symbol) {
+    nfa.AddTransition(0, symbol, 0);
+    for (State i = 1; i <= n; ++i) {
+      nfa.AddTransition(i, symbol, i + 1);
+    }
+  }
+  nfa.AddTransition(0, 'a', 1);
+  nfa.SetStartState(0, true);
+  nfa.SetFinalState(n + 1, true);
+  return nfa;
+}
+
+void SetCounters(benchmark::State& state, const DenseDeterministicAutomaton& dfa) {
+  state.counters["states"] = static_cast<double>(dfa.StatesCount());
+  state.counters["symbols"] = static_cast<double>(dfa.SymbolsCount());
+  state.counters["columns"] = static_cast<double>(dfa.ColumnsCount());
+  state.counters["bytes"] = static_cast<double>(dfa.MemoryUsage());
+}
+
+void BM_DeterminizeWideAlphabet(benchmark::State& state) {
+  auto nfa = WideBlowUp(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(nfa.ToDeterministic());
+  }
+  SetCounters(state, DenseDeterministicAutomaton{nfa});
+}
+
+void BM_MinimizeWideAlphabet(benchmark::State& state) {
+  DenseDeterministicAutomaton dfa{WideBlowUp(state)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dfa.Minimize());
+  }
+  SetCounters(state, dfa);
+}
+
+void BM_AcceptsWideAlphabet(benchmark::State& state) {
+  DenseDeterministicAutomaton dfa{WideBlowUp(state)};
+  auto corpus = generators::RandomWords(10'000, 16, 64, static_cast<std::size_t>(state.range(1)) - 'a', 3);
+  for (auto _ : state) {
+    std::size_t accepted = 0;
+    for (std::size_t word = 0; word + 1 != corpus.offsets.size(); ++word) {
+      accepted += dfa.Accepts(corpus.symbols.data() + corpus.offsets[word],
+                              corpus.symbols.data() + corpus.offsets[word + 1]);
+    }
+    benchmark::DoNotOptimize(accepted);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * corpus.symbols.size()));
+  SetCounters(state, dfa);
+}
+
+void Arguments(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Args({8, 128})->Args({8, 256})->Args({12, 256});
+}
+
+}  // namespace
+
+BENCHMARK(BM_DeterminizeWideAlphabet)->Apply(Arguments)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MinimizeWideAlphabet)->Apply(Arguments)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AcceptsWideAlphabet)->Apply(Arguments);
@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/batch.h>
+#include <cppformlang/finite_automata/interleaved_matcher.h>
+
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+struct Corpus {
+  std::vector<Symbol> symbols;
+  std::vector<std::size_t> offsets{0};
+
+  WordBatch Batch() const { return WordBatch{symbols.data(), offsets.data(), offsets.size() - 1}; }
+};
+
+/// a million short random words over {a, b, c}
+const Corpus& ShortWords() {
+  static const Corpus corpus = [] {
+    Corpus result;
+    std::mt19937 random{7};
+    for (auto word = 0; word != 1'000'000; ++word) {
+      for (auto length = 4 + random() % 12; length != 0; --length) {
+        result.symbols.push_back(static_cast<Symbol>('a' + random() % 3));
+      }
+      result.offsets.push_back(result.symbols.size());
+    }
+    return result;
+  }();
+  return corpus;
+}
+
+template <typename Automaton>
+void BM_AcceptsBatch(benchmark::State& state) {
+  Automaton automaton{NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)+(a|b)|(c+a*)*")};
+  utils::ThreadPool pool{static_cast<std::size_t>(state.range(0))};
+  auto batch = ShortWords().Batch();
+  std::vector<std::uint64_t> result((batch.words_count + 63) / 64);
+  for (auto _ : state) {
+    AcceptsBatch(automaton, batch, result.data(), &pool);
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch.words_count));
+}
+
+/// one word after another through DenseDeterministicAutomaton::Accepts
+void BM_AcceptsSequential(benchmark::State& state) {
+  DenseDeterministicAutomaton dfa{NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)+(a|b)|(c+a*)*")};
+  auto batch = ShortWords().Batch();
+  std::vector<std::uint64_t> result((batch.words_count + 63) / 64);
+  for (auto _ : state) {
+    for (std::size_t word = 0; word != batch.words_count; ++word) {
+      auto accepted = dfa.Accepts(batch.symbols + batch.offsets[word], batch.symbols + batch.offsets[word + 1]);
+      result[word / 64] |= std::uint64_t{accepted} << (word % 64);
+    }
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch.words_count));
+}
+
+void BM_AcceptsInterleaved(benchmark::State& state, InterleavedKernel kernel) {
+  DenseDeterministicAutomaton dfa{NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)+(a|b)|(c+a*)*")};
+  auto batch = ShortWords().Batch();
+  std::vector<std::uint64_t> result((batch.words_count + 63) / 64);
+  for (auto _ : state) {
+    AcceptsInterleaved(dfa, batch, 0, batch.words_count, result.data(), kernel);
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch.words_count));
+}
+
+void ThreadCounts(benchmark::internal::Benchmark* benchmark) {
+  auto hardware = std::max(1U, std::thread::hardware_concurrency());
+  unsigned threads = 1;
+  for (; threads < hardware; threads *= 2) {
+    benchmark->Arg(threads);
+  }
+  benchmark->Arg(hardware);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_AcceptsBatch, DenseDeterministicAutomaton)
+    ->Apply(ThreadCounts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_AcceptsBatch, CompactNondeterministicAutomaton)
+    ->Apply(ThreadCounts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AcceptsSequential)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AcceptsInterleaved, Scalar, InterleavedKernel::kScalar)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AcceptsInterleaved, Avx2, InterleavedKernel::kAvx2)->Unit(benchmark::kMillisecond);
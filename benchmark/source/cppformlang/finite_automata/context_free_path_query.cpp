@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/context_free_path_query.h>
+
+#include <random>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// every edge with its inverse labeled by the upper case letter
+void AddWithInverse(std::vector<LabeledEdge>& edges, State from, char label, State to) {
+  edges.push_back(LabeledEdge{from, label, to});
+  edges.push_back(LabeledEdge{to, static_cast<Symbol>(label - 'a' + 'A'), from});
+}
+
+/// an ontology: a random class tree of subclass (s) edges and instances with type (t) edges
+LabeledGraph OntologyGraph(std::size_t classes) {
+  std::mt19937 random{static_cast<std::mt19937::result_type>(classes)};
+  std::vector<LabeledEdge> edges;
+  for (State child = 1; child != classes; ++child) {
+    AddWithInverse(edges, child, 's', static_cast<State>(random() % child));
+  }
+  for (State instance = 0; instance != classes; ++instance) {
+    AddWithInverse(edges, static_cast<State>(classes + instance), 't', static_cast<State>(random() % classes));
+  }
+  return LabeledGraph{2 * classes, std::move(edges)};
+}
+
+/// the same generation query: S -> S' S s | T' S t | S' s | T' t
+RecursiveAutomaton SameGeneration() {
+  RecursiveAutomaton rsm;
+  rsm.SetInitLabel('X');
+  rsm.AddBox('X', NondeterministicFiniteAutomaton::FromRegex("S+X+s|T+X+t|S+s|T+t"));
+  return rsm;
+}
+
+/// a program: random assignment (a) and dereference (d) edges between variables
+LabeledGraph ProgramGraph(std::size_t variables) {
+  std::mt19937 random{static_cast<std::mt19937::result_type>(variables)};
+  std::vector<LabeledEdge> edges;
+  for (std::size_t i = 0; i != variables; ++i) {
+    AddWithInverse(edges, static_cast<State>(random() % variables), 'a', static_cast<State>(random() % variables));
+    if (i % 2 == 0) {
+      AddWithInverse(edges, static_cast<State>(random() % variables), 'd', static_cast<State>(random() % variables));
+    }
+  }
+  return LabeledGraph{variables, std::move(edges)};
+}
+
+/// the memory alias query: M -> D V d, V -> (M? A)* M? (a M?)*
+RecursiveAutomaton MemoryAlias() {
+  RecursiveAutomaton rsm;
+  rsm.SetInitLabel('M');
+  NondeterministicFiniteAutomaton m;
+  m.AddTransition(1, 'D', 2);
+  m.AddTransition(2, 'V', 3);
+  m.AddTransition(3, 'd', 4);
+  m.SetStartState(1, true);
+  m.SetFinalState(4, true);
+  rsm.AddBox('M', m);
+  NondeterministicFiniteAutomaton v;
+  v.AddTransition(1, 'A', 1);
+  v.AddTransition(1, 'M', 2);
+  v.AddTransition(2, 'A', 1);
+  v.AddTransition(1, 'M', 3);
+  v.AddTransition(1, kEpsilon, 3);
+  v.AddTransition(3, 'a', 3);
+  v.AddTransition(3, 'a', 4);
+  v.AddTransition(4, 'M', 3);
+  v.SetStartState(1, true);
+  v.SetFinalState(3, true);
+  rsm.AddBox('V', v);
+  return rsm;
+}
+
+void BM_SameGeneration(benchmark::State& state) {
+  auto graph = OntologyGraph(static_cast<std::size_t>(state.range(0)));
+  auto rsm = SameGeneration();
+  utils::ThreadPool pool{static_cast<std::size_t>(state.range(1))};
+  std::size_t pairs = 0;
+  for (auto _ : state) {
+    pairs = ContextFreePathQuery(rsm, graph, &pool).size();
+  }
+  state.counters["pairs"] = static_cast<double>(pairs);
+}
+
+void BM_MemoryAlias(benchmark::State& state) {
+  auto graph = ProgramGraph(static_cast<std::size_t>(state.range(0)));
+  auto rsm = MemoryAlias();
+  utils::ThreadPool pool{static_cast<std::size_t>(state.range(1))};
+  std::size_t pairs = 0;
+  for (auto _ : state) {
+    pairs = ContextFreePathQuery(rsm, graph, &pool).size();
+  }
+  state.counters["pairs"] = static_cast<double>(pairs);
+}
+
+}  // namespace
+
+BENCHMARK(BM_SameGeneration)->Args({1000, 1})->Args({10000, 1})->Args({10000, 4})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MemoryAlias)->Args({250, 1})->Args({500, 1})->Args({500, 4})->Unit(benchmark::kMillisecond);
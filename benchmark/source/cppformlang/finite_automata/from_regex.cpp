@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/nondeterministic_finite_automaton.h>
+#include <generators.h>
+
+#include <memory_resource>
+#include <string>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// a union of n alternatives of concatenated letters under a star
+std::string LongRegex(std::size_t n) {
+  std::string regex = "(";
+  for (std::size_t i = 0; i != n; ++i) {
+    if (i != 0) {
+      regex += "|";
+    }
+    regex += static_cast<char>('a' + i % 26);
+    regex += "+";
+    regex += static_cast<char>('a' + (i * 7 + 3) % 26);
+    regex += "+";
+    regex += static_cast<char>('a' + (i * 11 + 5) % 26);
+  }
+  return regex + ")*";
+}
+
+void BM_FromRegexHeap(benchmark::State& state) {
+  auto regex = LongRegex(static_cast<std::size_t>(state.range(0)));
+  generators::CountingResource counting;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(NondeterministicFiniteAutomaton::FromRegex(regex, &counting));
+  }
+  state.counters["allocations"] =
+      benchmark::Counter(static_cast<double>(counting.Allocations()), benchmark::Counter::kAvgIterations);
+}
+
+void BM_FromRegexArena(benchmark::State& state) {
+  auto regex = LongRegex(static_cast<std::size_t>(state.range(0)));
+  generators::CountingResource counting;
+  for (auto _ : state) {
+    std::pmr::monotonic_buffer_resource arena{&counting};
+    benchmark::DoNotOptimize(NondeterministicFiniteAutomaton::FromRegex(regex, &arena));
+  }
+  state.counters["allocations"] =
+      benchmark::Counter(static_cast<double>(counting.Allocations()), benchmark::Counter::kAvgIterations);
+}
+
+}  // namespace
+
+BENCHMARK(BM_FromRegexHeap)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK(BM_FromRegexArena)->RangeMultiplier(4)->Range(4, 256);
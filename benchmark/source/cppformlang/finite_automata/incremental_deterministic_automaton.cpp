@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/dense_deterministic_automaton.h>
+#include <cppformlang/finite_automata/incremental_deterministic_automaton.h>
+#include <generators.h>
+
+#include <random>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// args: words, a chain of states from state 0 for every random word, the subsets are the nodes of their trie
+NondeterministicFiniteAutomaton Source(benchmark::State& state) {
+  auto corpus = generators::RandomWords(static_cast<std::size_t>(state.range(0)), 4, 16, 4, 13);
+  NondeterministicFiniteAutomaton nfa;
+  State next = 1;
+  for (std::size_t word = 0; word + 1 != corpus.offsets.size(); ++word) {
+    State from = 0;
+    for (auto i = corpus.offsets[word]; i != corpus.offsets[word + 1]; ++i, from = next++) {
+      nfa.AddTransition(from, corpus.symbols[i], next);
+    }
+    nfa.SetFinalState(from, true);
+  }
+  nfa.SetStartState(0, true);
+  return nfa;
+}
+
+/// args: words, an edge is added and removed again, the subsets are rebuilt after both edits
+void BM_RebuildAfterEdit(benchmark::State& state) {
+  auto nfa = Source(state);
+  std::mt19937 random{3};
+  const auto states = static_cast<State>(nfa.StatesCount());
+  for (auto _ : state) {
+    const State from = random() % states;
+    const State to = random() % states;
+    if (nfa.AddTransition(from, 'a', to)) {
+      benchmark::DoNotOptimize(DenseDeterministicAutomaton{nfa});
+      nfa.RemoveTransition(from, 'a', to);
+    }
+    benchmark::DoNotOptimize(DenseDeterministicAutomaton{nfa});
+  }
+}
+
+/// args: words, the same edits on the maintained subsets
+void BM_IncrementalEdit(benchmark::State& state) {
+  IncrementalDeterministicAutomaton dfa{Source(state)};
+  std::mt19937 random{3};
+  const auto states = static_cast<State>(dfa.Source().StatesCount());
+  std::size_t updated = 0;
+  for (auto _ : state) {
+    const State from = random() % states;
+    const State to = random() % states;
+    if (dfa.AddTransition(from, 'a', to)) {
+      updated += dfa.LastUpdateSize();
+      dfa.RemoveTransition(from, 'a', to);
+      updated += dfa.LastUpdateSize();
+    }
+  }
+  state.counters["states"] = static_cast<double>(dfa.StatesCount());
+  state.counters["rows_per_edit"] =
+      benchmark::Counter(static_cast<double>(updated), benchmark::Counter::kAvgIterations);
+}
+
+/// args: words, the edits followed by the minimal automaton
+void BM_IncrementalEditMinimal(benchmark::State& state) {
+  IncrementalDeterministicAutomaton dfa{Source(state)};
+  std::mt19937 random{3};
+  const auto states = static_cast<State>(dfa.Source().StatesCount());
+  for (auto _ : state) {
+    const State from = random() % states;
+    const State to = random() % states;
+    if (dfa.AddTransition(from, 'a', to)) {
+      benchmark::DoNotOptimize(dfa.Minimal());
+      dfa.RemoveTransition(from, 'a', to);
+    }
+    benchmark::DoNotOptimize(dfa.Minimal());
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_RebuildAfterEdit)->Arg(1'000)->Arg(10'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IncrementalEdit)->Arg(1'000)->Arg(10'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_IncrementalEditMinimal)->Arg(1'000)->Arg(10'000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/dense_deterministic_automaton.h>
+#include <cppformlang/finite_automata/nondeterministic_finite_automaton.h>
+#include <cppformlang/finite_automata/product.h>
+#include <cppformlang/finite_automata/regex.h>
+#include <generators.h>
+
+#include <string>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// (a|b)*a^(n+1), a subset of BlowUpRegex(n) with a small automaton
+NondeterministicFiniteAutomaton Suffixes(std::size_t n) {
+  std::string regex = "(a|b)*+a";
+  for (std::size_t i = 0; i != n; ++i) {
+    regex += "+a";
+  }
+  return Regex::Parse(regex)->ToPositionAutomaton();
+}
+
+NondeterministicFiniteAutomaton BlowUp(std::size_t n) {
+  return Regex::Parse(generators::BlowUpRegex(n))->ToPositionAutomaton();
+}
+
+/// args: n, the inclusion by comparing the minimal automata of both sides and of their union
+void BM_InclusionByMinimization(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  auto left = Suffixes(n);
+  auto right = BlowUp(n);
+  for (auto _ : state) {
+    auto united = left;
+    united.Union(right);
+    benchmark::DoNotOptimize(DenseDeterministicAutomaton{united}.Minimize().StatesCount() ==
+                             DenseDeterministicAutomaton{right}.Minimize().StatesCount());
+  }
+}
+
+/// args: n, the difference with right determinized on the fly
+void BM_InclusionByDifference(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  auto left = Suffixes(n);
+  auto right = BlowUp(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(IsDifferenceEmpty(left, right));
+  }
+}
+
+/// args: n
+void BM_InclusionByAntichains(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  auto left = Suffixes(n);
+  auto right = BlowUp(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(left.IsSubsetOf(right));
+  }
+}
+
+/// args: n, two deterministic automata of BlowUpRegex(n), one of them minimal
+void BM_EquivalenceHopcroftKarp(benchmark::State& state) {
+  auto left = BlowUp(static_cast<std::size_t>(state.range(0))).ToDeterministic();
+  auto right = left.Minimize();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(left.IsEquivalent(right));
+  }
+  state.counters["states"] = static_cast<double>(left.StatesCount());
+}
+
+/// args: n, the same comparison by minimizing both automata
+void BM_EquivalenceByMinimization(benchmark::State& state) {
+  auto left = BlowUp(static_cast<std::size_t>(state.range(0))).ToDeterministic();
+  auto right = left.Minimize();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(DenseDeterministicAutomaton{left}.Minimize().StatesCount() ==
+                             DenseDeterministicAutomaton{right}.Minimize().StatesCount());
+  }
+  state.counters["states"] = static_cast<double>(left.StatesCount());
+}
+
+}  // namespace
+
+BENCHMARK(BM_InclusionByMinimization)->Arg(8)->Arg(12)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_InclusionByDifference)->Arg(8)->Arg(12)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_InclusionByAntichains)->Arg(8)->Arg(12)->Arg(64)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EquivalenceHopcroftKarp)->Arg(8)->Arg(12)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EquivalenceByMinimization)->Arg(8)->Arg(12)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/minimization.h>
+
+#include <random>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// a random automaton of `states` states that collapses to at most `states / 8` classes
+DenseDeterministicAutomaton RedundantAutomaton(std::size_t states, std::size_t columns) {
+  std::mt19937 random{static_cast<std::mt19937::result_type>(states)};
+  const auto classes = std::max<std::size_t>(states / 8, 1);
+  std::vector<State> class_next(classes * columns);
+  for (auto& to : class_next) {
+    to = static_cast<State>(random() % classes);
+  }
+  std::vector<Symbol> symbols;
+  for (std::size_t column = 0; column != columns; ++column) {
+    symbols.push_back(static_cast<Symbol>(column));
+  }
+  // state s is a copy of class s % classes and goes to a random copy of the class target
+  std::vector<State> next(states * columns);
+  for (std::size_t state = 0; state != states; ++state) {
+    for (std::size_t column = 0; column != columns; ++column) {
+      auto copies = (states - 1 - class_next[state % classes * columns + column]) / classes + 1;
+      next[state * columns + column] =
+          static_cast<State>(class_next[state % classes * columns + column] + random() % copies * classes);
+    }
+  }
+  std::vector<State> final_states;
+  for (std::size_t state = 0; state != states; ++state) {
+    if (state % classes % 3 == 0) {
+      final_states.push_back(static_cast<State>(state));
+    }
+  }
+  return DenseDeterministicAutomaton{std::move(symbols), std::move(next), final_states, 0};
+}
+
+/// a cycle of `states` states with one final state, Moore needs about `states` rounds on it
+DenseDeterministicAutomaton CycleAutomaton(std::size_t states) {
+  std::vector<State> next(states);
+  for (std::size_t state = 0; state != states; ++state) {
+    next[state] = static_cast<State>((state + 1) % states);
+  }
+  return DenseDeterministicAutomaton{{0}, std::move(next), {static_cast<State>(states - 1)}, 0};
+}
+
+template <typename Partition>
+void BM_Partition(benchmark::State& state, Partition partition) {
+  auto dfa = RedundantAutomaton(static_cast<std::size_t>(state.range(0)), 4);
+  auto labels = FinalLabels(dfa);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(partition(dfa, labels));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Partition>
+void BM_PartitionCycle(benchmark::State& state, Partition partition) {
+  auto dfa = CycleAutomaton(static_cast<std::size_t>(state.range(0)));
+  auto labels = FinalLabels(dfa);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(partition(dfa, labels));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Minimize(benchmark::State& state) {
+  auto dfa = RedundantAutomaton(static_cast<std::size_t>(state.range(0)), 4);
+  for (auto _ : state) {
+    auto minimal = dfa.Minimize();
+    state.counters["states"] = static_cast<double>(minimal.StatesCount());
+  }
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_Partition, Hopcroft, HopcroftPartition)
+    ->RangeMultiplier(10)
+    ->Range(100'000, 1'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Partition, Moore, MoorePartition)
+    ->RangeMultiplier(10)
+    ->Range(100'000, 1'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_PartitionCycle, Hopcroft, HopcroftPartition)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 100'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_PartitionCycle, Moore, MoorePartition)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 10'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Minimize)->RangeMultiplier(10)->Range(100'000, 1'000'000)->Unit(benchmark::kMillisecond);
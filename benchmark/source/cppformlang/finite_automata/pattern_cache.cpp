@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/pattern_cache.h>
+#include <cppformlang/finite_automata/regex.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// a service workload: 64 distinct patterns requested with a skewed frequency
+std::vector<std::string> Requests() {
+  std::vector<std::string> patterns;
+  for (auto i = 0; i != 64; ++i) {
+    std::string regex = "(a|b)*+";
+    regex += static_cast<char>('a' + i % 3);
+    for (auto j = 0; j != 4 + i % 5; ++j) {
+      regex += "+(a|b|" + std::string(1, static_cast<char>('c' + (i + j) % 20)) + ")";
+    }
+    patterns.push_back(regex);
+  }
+  std::mt19937 random{5};
+  std::vector<std::string> requests;
+  for (auto i = 0; i != 4096; ++i) {
+    requests.push_back(patterns[std::min(random() % 64, random() % 64)]);
+  }
+  return requests;
+}
+
+void BM_CompileEveryRequest(benchmark::State& state) {
+  auto requests = Requests();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto& regex = requests[i++ % requests.size()];
+    benchmark::DoNotOptimize(DenseDeterministicAutomaton{Regex::Parse(regex)->ToPositionAutomaton()}.Minimize());
+  }
+}
+
+/// args: capacity in KiB, the threads share one cache
+void BM_PatternCache(benchmark::State& state) {
+  static PatternCache* cache = nullptr;
+  if (state.thread_index() == 0) {
+    cache = new PatternCache{static_cast<std::size_t>(state.range(0)) << 10};
+  }
+  auto requests = Requests();
+  std::size_t i = static_cast<std::size_t>(state.thread_index()) * 97;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cache->Get(requests[i++ % requests.size()]));
+  }
+  if (state.thread_index() == 0) {
+    auto stats = cache->GetStats();
+    state.counters["hit_rate"] = static_cast<double>(stats.hits) / static_cast<double>(stats.hits + stats.misses);
+    state.counters["evictions"] = static_cast<double>(stats.evictions);
+    delete cache;
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_CompileEveryRequest);
+BENCHMARK(BM_PatternCache)->Arg(64)->Arg(4096)->Threads(1)->Threads(4);
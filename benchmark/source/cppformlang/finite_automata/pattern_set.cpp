@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/pattern_set.h>
+#include <cppformlang/finite_automata/regex.h>
+#include <generators.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// n patterns: a prefix of three letters of a..h, then a tail that differs by pattern
+std::vector<std::string> Patterns(std::size_t n) {
+  std::mt19937 random{23};
+  std::vector<std::string> patterns;
+  for (std::size_t i = 0; i != n; ++i) {
+    std::string pattern;
+    for (auto j = 0; j != 3; ++j) {
+      pattern += static_cast<char>('a' + random() % 8);
+    }
+    pattern += i % 2 == 0 ? "+(a|b|c)*" : "+(d|e)*+f";
+    patterns.push_back(pattern);
+  }
+  return patterns;
+}
+
+const generators::Corpus& Words() {
+  static const auto corpus = generators::RandomWords(10'000, 4, 16, 8, 29);
+  return corpus;
+}
+
+/// args: patterns count
+void BM_SeparateAutomata(benchmark::State& state) {
+  std::vector<DenseDeterministicAutomaton> automata;
+  for (auto& pattern : Patterns(static_cast<std::size_t>(state.range(0)))) {
+    automata.emplace_back(DenseDeterministicAutomaton{Regex::Parse(pattern)->ToPositionAutomaton()}.Minimize());
+  }
+  const auto& corpus = Words();
+  for (auto _ : state) {
+    std::size_t matches = 0;
+    for (std::size_t word = 0; word + 1 != corpus.offsets.size(); ++word) {
+      for (auto& automaton : automata) {
+        matches += automaton.Accepts(corpus.symbols.data() + corpus.offsets[word],
+                                     corpus.symbols.data() + corpus.offsets[word + 1]);
+      }
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * (corpus.offsets.size() - 1)));
+}
+
+void BM_PatternSet(benchmark::State& state) {
+  auto set = PatternSet::Compile(Patterns(static_cast<std::size_t>(state.range(0))));
+  const auto& corpus = Words();
+  for (auto _ : state) {
+    std::size_t matches = 0;
+    for (std::size_t word = 0; word + 1 != corpus.offsets.size(); ++word) {
+      matches += set->Match(corpus.symbols.data() + corpus.offsets[word],
+                            corpus.symbols.data() + corpus.offsets[word + 1])
+                     .size();
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * (corpus.offsets.size() - 1)));
+  state.counters["states"] = static_cast<double>(set->Automaton().StatesCount());
+  state.counters["tag_sets"] = static_cast<double>(set->TagSetsCount());
+}
+
+void BM_PatternSetCompile(benchmark::State& state) {
+  auto patterns = Patterns(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(PatternSet::Compile(patterns));
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_SeparateAutomata)->Arg(10)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PatternSet)->Arg(10)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PatternSetCompile)->Arg(10)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,137 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/dense_deterministic_automaton.h>
+#include <cppformlang/finite_automata/nondeterministic_finite_automaton.h>
+#include <generators.h>
+
+#include <string>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// args: states, epsilon ratio in percent, a random automaton with 2 transitions by each of 2 symbols per state
+NondeterministicFiniteAutomaton RandomAutomaton(benchmark::State& state) {
+  return generators::RandomNondeterministic(static_cast<std::size_t>(state.range(0)), 2, 2.0,
+                                            static_cast<double>(state.range(1)) / 100, 42);
+}
+
+/// args: n, the automaton of the blow-up regex
+NondeterministicFiniteAutomaton BlowUp(benchmark::State& state) {
+  return generators::BlowUpAutomaton(static_cast<std::size_t>(state.range(0)));
+}
+
+void RandomArguments(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Args({64, 0})->Args({64, 50})->Args({1024, 0})->Args({1024, 50});
+}
+
+/// args: n of the blow-up regex
+void BM_PipelineFromRegex(benchmark::State& state) {
+  auto regex = generators::BlowUpRegex(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(NondeterministicFiniteAutomaton::FromRegex(regex));
+  }
+}
+
+void BM_PipelineEclose(benchmark::State& state) {
+  auto nfa = RandomAutomaton(state);
+  for (auto _ : state) {
+    std::size_t closed = 0;
+    nfa.ForeachState([&](State from) { closed += nfa.Eclose(from).size(); });
+    benchmark::DoNotOptimize(closed);
+  }
+}
+
+void BM_PipelineRemoveEpsilon(benchmark::State& state) {
+  auto nfa = RandomAutomaton(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(nfa.RemoveEpsilon());
+  }
+}
+
+/// the random automata of 1024 states have too many subsets, the blow-up regex is determinized instead
+void BM_PipelineToDeterministic(benchmark::State& state) {
+  auto nfa = BlowUp(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(nfa.ToDeterministic());
+  }
+  state.counters["states"] = static_cast<double>(nfa.ToDeterministic().StatesCount());
+}
+
+void BM_PipelineMinimize(benchmark::State& state) {
+  auto nfa = BlowUp(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(nfa.Minimize());
+  }
+  state.counters["states"] = static_cast<double>(nfa.Minimize().StatesCount());
+}
+
+/// args: n of the blow-up regex, words of 16..64 symbols over {a, b}
+template <bool kDense>
+void BM_PipelineAccepts(benchmark::State& state) {
+  auto nfa = BlowUp(state);
+  DenseDeterministicAutomaton dfa{nfa};
+  auto corpus = generators::RandomWords(1024, 16, 64, 2, 7);
+  for (auto _ : state) {
+    std::size_t accepted = 0;
+    for (std::size_t word = 0; word + 1 < corpus.offsets.size(); ++word) {
+      auto begin = corpus.symbols.data() + corpus.offsets[word];
+      auto end = corpus.symbols.data() + corpus.offsets[word + 1];
+      accepted += kDense ? dfa.Accepts(begin, end) : nfa.Accepts(begin, end);
+    }
+    benchmark::DoNotOptimize(accepted);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * corpus.symbols.size()));
+}
+
+void BM_PipelineUnion(benchmark::State& state) {
+  auto left = RandomAutomaton(state);
+  auto right = generators::RandomNondeterministic(static_cast<std::size_t>(state.range(0)), 2, 2.0,
+                                                  static_cast<double>(state.range(1)) / 100, 43);
+  for (auto _ : state) {
+    auto result = left;
+    result.Union(right);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+void BM_PipelineConcatenate(benchmark::State& state) {
+  auto left = RandomAutomaton(state);
+  auto right = generators::RandomNondeterministic(static_cast<std::size_t>(state.range(0)), 2, 2.0,
+                                                  static_cast<double>(state.range(1)) / 100, 43);
+  for (auto _ : state) {
+    auto result = left;
+    result.Concatenate(right);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+/// the bytes held by a copy of a random automaton built in a counting resource
+void BM_PipelineMemoryFootprint(benchmark::State& state) {
+  auto source = RandomAutomaton(state);
+  std::size_t transitions = 0;
+  source.ForeachTransition([&](State, Symbol, State) { ++transitions; });
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    generators::CountingResource counting;
+    {
+      NondeterministicFiniteAutomaton nfa{&counting};
+      source.ForeachTransition([&](State from, Symbol by, State to) { nfa.AddTransition(from, by, to); });
+      bytes = counting.Bytes();
+    }
+  }
+  state.counters["bytes"] = static_cast<double>(bytes);
+  state.counters["bytes_per_transition"] = static_cast<double>(bytes) / static_cast<double>(transitions);
+}
+
+}  // namespace
+
+BENCHMARK(BM_PipelineFromRegex)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_PipelineEclose)->Apply(RandomArguments);
+BENCHMARK(BM_PipelineRemoveEpsilon)->Apply(RandomArguments);
+BENCHMARK(BM_PipelineToDeterministic)->Arg(8)->Arg(12)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PipelineMinimize)->Arg(8)->Arg(12)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PipelineAccepts, false)->Arg(4)->Arg(12);
+BENCHMARK_TEMPLATE(BM_PipelineAccepts, true)->Arg(4)->Arg(12);
+BENCHMARK(BM_PipelineUnion)->Apply(RandomArguments);
+BENCHMARK(BM_PipelineConcatenate)->Apply(RandomArguments);
+BENCHMARK(BM_PipelineMemoryFootprint)->Apply(RandomArguments);
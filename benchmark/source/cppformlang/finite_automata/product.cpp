@@ -0,0 +1,29 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/product.h>
+#include <generators.h>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+void BM_BuildDifference(benchmark::State& state) {
+  auto left = NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+a");
+  auto right = generators::BlowUpAutomaton(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto difference = Difference(left, right);
+    benchmark::DoNotOptimize(difference.FinalStatesCount() == 0);
+  }
+}
+
+void BM_IsDifferenceEmpty(benchmark::State& state) {
+  auto left = NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+a");
+  auto right = generators::BlowUpAutomaton(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(IsDifferenceEmpty(left, right));
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_BuildDifference)->DenseRange(6, 12, 2)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_IsDifferenceEmpty)->DenseRange(6, 12, 2)->Unit(benchmark::kMicrosecond);
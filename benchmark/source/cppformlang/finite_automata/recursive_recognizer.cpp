@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/recursive_recognizer.h>
+
+#include <random>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+NondeterministicFiniteAutomaton Box(const char* regex) { return NondeterministicFiniteAutomaton::FromRegex(regex); }
+
+/// S -> ( S ) S | eps, the nullable box is written without epsilon transitions
+RecursiveAutomaton Dyck() {
+  NondeterministicFiniteAutomaton box;
+  box.AddTransition(1, '(', 2);
+  box.AddTransition(2, 'S', 3);
+  box.AddTransition(3, ')', 4);
+  box.AddTransition(4, 'S', 5);
+  box.SetStartState(1, true);
+  box.SetFinalState(1, true);
+  box.SetFinalState(5, true);
+  RecursiveAutomaton rsm;
+  rsm.SetInitLabel('S');
+  rsm.AddBox('S', box);
+  return rsm;
+}
+
+/// E -> E + T | T, T -> T * F | F, F -> ( E ) | a, with the left recursion kept
+RecursiveAutomaton Expressions() {
+  RecursiveAutomaton rsm;
+  rsm.SetInitLabel('E');
+  rsm.AddBox('E', Box("E+\\++T|T"));
+  rsm.AddBox('T', Box("T+\\*+F|F"));
+  rsm.AddBox('F', Box("\\(+E+\\)|a"));
+  return rsm;
+}
+
+std::vector<Symbol> RandomDyck(std::size_t length, std::mt19937& random) {
+  std::vector<Symbol> word;
+  std::size_t depth = 0;
+  while (word.size() + depth < length) {
+    bool open = depth == 0 || random() % 2 == 0;
+    word.push_back(open ? '(' : ')');
+    depth = open ? depth + 1 : depth - 1;
+  }
+  word.insert(word.end(), depth, ')');
+  return word;
+}
+
+void RandomExpression(std::size_t length, std::mt19937& random, std::vector<Symbol>& word) {
+  if (length <= 1) {
+    word.push_back('a');
+  } else if (random() % 4 == 0) {
+    word.push_back('(');
+    RandomExpression(length - 2, random, word);
+    word.push_back(')');
+  } else {
+    auto left = 1 + random() % (length - 1);
+    RandomExpression(left, random, word);
+    word.push_back(random() % 2 == 0 ? '+' : '*');
+    RandomExpression(length - left, random, word);
+  }
+}
+
+void BM_RecognizeDyck(benchmark::State& state) {
+  RecursiveRecognizer recognizer{Dyck()};
+  std::mt19937 random{1};
+  auto word = RandomDyck(static_cast<std::size_t>(state.range(0)), random);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(recognizer.Accepts(word.data(), word.data() + word.size()));
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * word.size()));
+}
+
+void BM_RecognizeExpression(benchmark::State& state) {
+  RecursiveRecognizer recognizer{Expressions()};
+  std::mt19937 random{2};
+  std::vector<Symbol> word;
+  RandomExpression(static_cast<std::size_t>(state.range(0)), random, word);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(recognizer.Accepts(word.data(), word.data() + word.size()));
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * word.size()));
+}
+
+/// S -> S S | a has a Catalan number of derivations of a^n, the cubic worst case
+void BM_RecognizeAmbiguous(benchmark::State& state) {
+  RecursiveAutomaton rsm;
+  rsm.SetInitLabel('S');
+  rsm.AddBox('S', Box("S+S|a"));
+  RecursiveRecognizer recognizer{rsm};
+  std::vector<Symbol> word(static_cast<std::size_t>(state.range(0)), 'a');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(recognizer.Accepts(word.data(), word.data() + word.size()));
+  }
+}
+
+/// args: threads, the words are 100000 Dyck words of up to 64 symbols
+void BM_RecursiveAcceptsBatch(benchmark::State& state) {
+  RecursiveRecognizer recognizer{Dyck()};
+  std::mt19937 random{3};
+  std::vector<Symbol> symbols;
+  std::vector<std::size_t> offsets{0};
+  for (auto word = 0; word != 100'000; ++word) {
+    auto symbols_of_word = RandomDyck(2 * (random() % 32), random);
+    symbols.insert(symbols.end(), symbols_of_word.begin(), symbols_of_word.end());
+    offsets.push_back(symbols.size());
+  }
+  const WordBatch batch{symbols.data(), offsets.data(), offsets.size() - 1};
+  std::vector<std::uint64_t> result((batch.words_count + 63) / 64);
+  utils::ThreadPool pool{static_cast<std::size_t>(state.range(0))};
+  for (auto _ : state) {
+    AcceptsBatch(recognizer, batch, result.data(), &pool);
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * symbols.size()));
+}
+
+}  // namespace
+
+BENCHMARK(BM_RecognizeDyck)->Arg(10'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RecognizeExpression)->Arg(10'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RecognizeAmbiguous)->Arg(50)->Arg(100)->Arg(200)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RecursiveAcceptsBatch)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/regex.h>
+
+#include <string>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// a union of n alternatives of three letters under a star
+std::string UnionRegex(std::size_t n) {
+  std::string regex = "(";
+  for (std::size_t i = 0; i != n; ++i) {
+    if (i != 0) {
+      regex += "|";
+    }
+    regex += static_cast<char>('a' + i % 26);
+    regex += "+";
+    regex += static_cast<char>('a' + (i * 7 + 3) % 26);
+    regex += "+";
+    regex += static_cast<char>('a' + (i * 11 + 5) % 26);
+  }
+  return regex + ")*";
+}
+
+/// n nested stars of a concatenation, every level adds a union and a star
+std::string NestedRegex(std::size_t n) {
+  std::string regex = "a";
+  for (std::size_t i = 0; i != n; ++i) {
+    regex = "(" + regex + "|" + static_cast<char>('b' + i % 24) + ")*+" + static_cast<char>('a' + (i * 5) % 26);
+  }
+  return regex;
+}
+
+std::string Regex(benchmark::State& state) {
+  auto n = static_cast<std::size_t>(state.range(1));
+  return state.range(0) == 0 ? UnionRegex(n) : NestedRegex(n);
+}
+
+void SetCounters(benchmark::State& state, const NondeterministicFiniteAutomaton& nfa) {
+  state.counters["states"] = static_cast<double>(nfa.StatesCount());
+  state.counters["symbols"] = static_cast<double>(nfa.SymbolsCount());
+}
+
+/// args: family (0 union, 1 nested), size
+void BM_CompileThompson(benchmark::State& state) {
+  auto regex = Regex(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(NondeterministicFiniteAutomaton::FromRegex(regex));
+  }
+  SetCounters(state, NondeterministicFiniteAutomaton::FromRegex(regex));
+}
+
+void BM_CompileGlushkov(benchmark::State& state) {
+  auto regex = Regex(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Regex::Parse(regex)->ToPositionAutomaton());
+  }
+  SetCounters(state, Regex::Parse(regex)->ToPositionAutomaton());
+}
+
+/// the epsilon transitions of Thompson's automaton are closed by the subset construction
+void BM_DeterminizeThompson(benchmark::State& state) {
+  auto nfa = NondeterministicFiniteAutomaton::FromRegex(Regex(state));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(nfa.ToDeterministic());
+  }
+  SetCounters(state, nfa.ToDeterministic());
+}
+
+void BM_DeterminizeGlushkov(benchmark::State& state) {
+  auto nfa = Regex::Parse(Regex(state))->ToPositionAutomaton();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(nfa.ToDeterministic());
+  }
+  SetCounters(state, nfa.ToDeterministic());
+}
+
+void Arguments(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Args({0, 16})->Args({0, 256})->Args({1, 8})->Args({1, 64});
+}
+
+}  // namespace
+
+BENCHMARK(BM_CompileThompson)->Apply(Arguments);
+BENCHMARK(BM_CompileGlushkov)->Apply(Arguments);
+BENCHMARK(BM_DeterminizeThompson)->Apply(Arguments);
+BENCHMARK(BM_DeterminizeGlushkov)->Apply(Arguments);
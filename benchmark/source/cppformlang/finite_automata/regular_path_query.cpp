@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/regular_path_query.h>
+
+#include <random>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// a random graph with edges / 8 vertices and the labels a, b, c
+LabeledGraph RandomGraph(std::size_t edges_count) {
+  std::mt19937 random{static_cast<std::mt19937::result_type>(edges_count)};
+  const auto vertices = edges_count / 8;
+  std::vector<LabeledEdge> edges;
+  edges.reserve(edges_count);
+  for (std::size_t i = 0; i != edges_count; ++i) {
+    edges.push_back(LabeledEdge{static_cast<State>(random() % vertices), static_cast<Symbol>('a' + random() % 3),
+                                static_cast<State>(random() % vertices)});
+  }
+  return LabeledGraph{vertices, std::move(edges)};
+}
+
+/// args: edges, sources, threads
+void BM_RegularPathQuery(benchmark::State& state) {
+  auto graph = RandomGraph(static_cast<std::size_t>(state.range(0)));
+  CompactNondeterministicAutomaton query{NondeterministicFiniteAutomaton::FromRegex("a+b+(a|c)+c")};
+  std::vector<State> sources;
+  for (State source = 0; source != static_cast<State>(state.range(1)); ++source) {
+    sources.push_back(source);
+  }
+  utils::ThreadPool pool{static_cast<std::size_t>(state.range(2))};
+  std::size_t pairs = 0;
+  for (auto _ : state) {
+    pairs = RegularPathQuery(graph, query, sources, &pool).size();
+  }
+  state.counters["pairs"] = static_cast<double>(pairs);
+}
+
+}  // namespace
+
+BENCHMARK(BM_RegularPathQuery)
+    ->Args({1 << 17, 1024, 1})
+    ->Args({1 << 20, 1024, 1})
+    ->Args({1 << 20, 1024, 4})
+    ->Args({10'000'000, 1024, 1})
+    ->Args({10'000'000, 1024, 4})
+    ->Unit(benchmark::kMillisecond);
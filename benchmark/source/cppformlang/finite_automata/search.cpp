@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/dense_deterministic_automaton.h>
+#include <cppformlang/finite_automata/regex.h>
+#include <cppformlang/finite_automata/search.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+const std::vector<std::string> kRegexes{
+    "needle+(a|b)*",         // every match begins with the literal
+    "(a|b)*+needle+(a|b)",   // the literal is inside the matches
+    "(ab|ba)+(a|b|c)*+c",    // no literal
+};
+
+/// random lowercase text with a needle every 4096 bytes
+std::string Text(std::size_t size) {
+  std::mt19937 random{41};
+  std::string text(size, 'a');
+  for (auto& byte : text) {
+    byte = static_cast<char>('a' + random() % 26);
+  }
+  for (std::size_t at = 4096; at + 8 < size; at += 4096) {
+    text.replace(at - 2, 8, "abneedle");
+  }
+  return text;
+}
+
+/// args: regex, text size, the search by Accepts over every substring with the minimal automaton
+void BM_SubstringAccepts(benchmark::State& state) {
+  auto dfa = DenseDeterministicAutomaton{Regex::Parse(kRegexes[state.range(0)])->ToPositionAutomaton()}.Minimize();
+  auto text = Text(static_cast<std::size_t>(state.range(1)));
+  std::vector<Symbol> symbols(text.begin(), text.end());
+  for (auto _ : state) {
+    std::size_t matches = 0;
+    for (std::size_t from = 0; from <= symbols.size();) {
+      std::size_t end = 0;
+      bool found = false;
+      for (auto begin = from; begin <= symbols.size() && !found; ++begin) {
+        for (end = symbols.size() + 1; end-- > begin;) {
+          if (dfa.Accepts(symbols.data() + begin, symbols.data() + end)) {
+            found = true;
+            break;
+          }
+        }
+      }
+      if (!found) {
+        break;
+      }
+      ++matches;
+      from = end;
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * text.size()));
+}
+
+/// args: regex, text size
+void BM_FindAll(benchmark::State& state) {
+  auto searcher = Searcher::Compile(kRegexes[state.range(0)]);
+  auto text = Text(static_cast<std::size_t>(state.range(1)));
+  std::size_t matches = 0;
+  for (auto _ : state) {
+    matches = searcher->FindAll(text).size();
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * text.size()));
+  state.counters["matches"] = static_cast<double>(matches);
+}
+
+}  // namespace
+
+BENCHMARK(BM_SubstringAccepts)->ArgsProduct({{0, 1, 2}, {1 << 10}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FindAll)->ArgsProduct({{0, 1, 2}, {1 << 10, 1 << 24}})->Unit(benchmark::kMillisecond);
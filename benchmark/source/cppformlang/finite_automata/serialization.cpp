@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/serialization.h>
+#include <generators.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+std::string SavedAutomaton(std::size_t n) {
+  auto name = "cppformlang_benchmark_" + std::to_string(n) + ".bin";
+  auto path = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream out{path, std::ios::binary};
+  Save(DenseDeterministicAutomaton{generators::BlowUpAutomaton(n)}, out);
+  return path;
+}
+
+const Symbol kWord[] = {'b', 'a', 'b', 'a', 'a', 'b', 'a', 'b', 'b', 'a', 'a', 'a'};
+
+void BM_CompileRegex(benchmark::State& state) {
+  auto regex = generators::BlowUpRegex(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    DenseDeterministicAutomaton dfa{NondeterministicFiniteAutomaton::FromRegex(regex)};
+    benchmark::DoNotOptimize(dfa.Accepts(std::begin(kWord), std::end(kWord)));
+  }
+}
+
+void BM_LoadDense(benchmark::State& state) {
+  auto path = SavedAutomaton(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::ifstream in{path, std::ios::binary};
+    auto dfa = LoadDenseDeterministic(in);
+    benchmark::DoNotOptimize(dfa->Accepts(std::begin(kWord), std::end(kWord)));
+  }
+  std::remove(path.c_str());
+}
+
+void BM_MapDense(benchmark::State& state) {
+  auto path = SavedAutomaton(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto dfa = MappedDeterministicAutomaton::Open(path);
+    benchmark::DoNotOptimize(dfa->Accepts(std::begin(kWord), std::end(kWord)));
+  }
+  std::remove(path.c_str());
+}
+
+void BM_MapDenseUnchecked(benchmark::State& state) {
+  auto path = SavedAutomaton(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto dfa = MappedDeterministicAutomaton::OpenUnchecked(path);
+    benchmark::DoNotOptimize(dfa->Accepts(std::begin(kWord), std::end(kWord)));
+  }
+  std::remove(path.c_str());
+}
+
+}  // namespace
+
+BENCHMARK(BM_CompileRegex)->DenseRange(8, 14, 2)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LoadDense)->DenseRange(8, 14, 2)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MapDense)->DenseRange(8, 14, 2)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MapDenseUnchecked)->DenseRange(8, 14, 2)->Unit(benchmark::kMicrosecond);
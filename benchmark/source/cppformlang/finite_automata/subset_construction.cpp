@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include <cppformlang/finite_automata/nondeterministic_finite_automaton.h>
+#include <generators.h>
+
+#include <thread>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+void BM_ToDeterministic(benchmark::State& state) {
+  auto nfa = generators::BlowUpAutomaton(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(nfa.ToDeterministic());
+  }
+}
+
+void BM_ParallelToDeterministic(benchmark::State& state) {
+  auto nfa = generators::BlowUpAutomaton(static_cast<std::size_t>(state.range(0)));
+  auto threads = static_cast<std::size_t>(state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(nfa.ToDeterministic(threads));
+  }
+  state.counters["threads"] = static_cast<double>(threads);
+}
+
+void ThreadCounts(benchmark::internal::Benchmark* benchmark) {
+  auto hardware = std::max(1U, std::thread::hardware_concurrency());
+  for (auto n : {10, 14}) {
+    unsigned threads = 1;
+    for (; threads < hardware; threads *= 2) {
+      benchmark->Args({n, threads});
+    }
+    benchmark->Args({n, hardware});
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_ToDeterministic)->Arg(10)->Arg(14)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelToDeterministic)->Apply(ThreadCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
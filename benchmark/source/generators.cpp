@@ -0,0 +1,66 @@
+#include <generators.h>
+
+#include <random>
+
+namespace generators {
+
+using cppformlang::finite_automata::kEpsilon;
+using cppformlang::finite_automata::State;
+
+std::string BlowUpRegex(std::size_t n) {
+  std::string regex = "(a|b)*+a";
+  for (std::size_t i = 0; i != n; ++i) {
+    regex += "+(a|b)";
+  }
+  return regex;
+}
+
+NondeterministicFiniteAutomaton BlowUpAutomaton(std::size_t n) {
+  return NondeterministicFiniteAutomaton::FromRegex(BlowUpRegex(n));
+}
+
+NondeterministicFiniteAutomaton RandomNondeterministic(std::size_t states, std::size_t symbols, double density,
+                                                        double epsilon_ratio, std::uint32_t seed) {
+  std::mt19937 random{seed};
+  std::uniform_int_distribution<State> target{1, static_cast<State>(states)};
+  // the number of transitions of a state by a symbol is binomial with mean density
+  std::binomial_distribution<int> letters{static_cast<int>(2 * density + 1), density / (2 * density + 1)};
+  std::binomial_distribution<int> epsilons{static_cast<int>(2 * density + 1),
+                                           density * epsilon_ratio / (2 * density + 1)};
+  NondeterministicFiniteAutomaton nfa;
+  for (State from = 1; from <= states; ++from) {
+    for (std::size_t symbol = 0; symbol != symbols; ++symbol) {
+      for (auto count = letters(random); count != 0; --count) {
+        nfa.AddTransition(from, static_cast<Symbol>('a' + symbol), target(random));
+      }
+    }
+    for (auto count = epsilons(random); count != 0; --count) {
+      nfa.AddTransition(from, kEpsilon, target(random));
+    }
+    // a transition to the next state keeps every state in the automaton
+    nfa.AddTransition(from, 'a', from % states + 1);
+  }
+  nfa.SetStartState(1, true);
+  for (State state = 1; state <= states; state += 4) {
+    nfa.SetFinalState(state, true);
+  }
+  return nfa;
+}
+
+Corpus RandomWords(std::size_t count, std::size_t min_length, std::size_t max_length, std::size_t symbols,
+                   std::uint32_t seed) {
+  std::mt19937 random{seed};
+  std::uniform_int_distribution<std::size_t> length{min_length, max_length};
+  std::uniform_int_distribution<int> symbol{0, static_cast<int>(symbols) - 1};
+  Corpus corpus;
+  corpus.offsets.reserve(count + 1);
+  for (std::size_t word = 0; word != count; ++word) {
+    for (auto left = length(random); left != 0; --left) {
+      corpus.symbols.push_back(static_cast<Symbol>('a' + symbol(random)));
+    }
+    corpus.offsets.push_back(corpus.symbols.size());
+  }
+  return corpus;
+}
+
+}  // namespace generators
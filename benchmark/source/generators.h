@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cppformlang/finite_automata/batch.h>
+#include <cppformlang/finite_automata/nondeterministic_finite_automaton.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Deterministic workloads shared by the benchmarks
+ *
+ * \details Every generator takes its seed explicitly, so two builds of the
+ * benchmark run on the same automata and words and their JSON outputs can
+ * be compared.
+ */
+namespace generators {
+
+using cppformlang::finite_automata::NondeterministicFiniteAutomaton;
+using cppformlang::finite_automata::Symbol;
+using cppformlang::finite_automata::WordBatch;
+
+/**
+ * \brief (a|b)*a(a|b)^n, its minimal deterministic automaton has 2^(n+1) states
+ */
+std::string BlowUpRegex(std::size_t n);
+
+/**
+ * \brief The automaton of BlowUpRegex(n) built by FromRegex
+ */
+NondeterministicFiniteAutomaton BlowUpAutomaton(std::size_t n);
+
+/**
+ * \brief A random automaton with states 1..states over the symbols 'a'..
+ *
+ * \details Every state has about density transitions by every symbol and
+ * about density * epsilon_ratio epsilon transitions, to random states. State
+ * 1 is the start state and every fourth state is final.
+ */
+NondeterministicFiniteAutomaton RandomNondeterministic(std::size_t states, std::size_t symbols, double density,
+                                                        double epsilon_ratio, std::uint32_t seed);
+
+/**
+ * \brief Many words stored in one buffer, see WordBatch
+ */
+struct Corpus {
+  std::vector<Symbol> symbols;
+  std::vector<std::size_t> offsets{0};
+
+  WordBatch Batch() const { return WordBatch{symbols.data(), offsets.data(), offsets.size() - 1}; }
+};
+
+/**
+ * \brief Random words of min_length..max_length symbols over the symbols 'a'..
+ */
+Corpus RandomWords(std::size_t count, std::size_t min_length, std::size_t max_length, std::size_t symbols,
+                   std::uint32_t seed);
+
+/**
+ * \brief Forwards to an upstream resource and counts the calls and the bytes in use
+ */
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+      : upstream_{upstream} {}
+
+  std::size_t Allocations() const { return allocations_; }
+  std::size_t Bytes() const { return bytes_; }
+  std::size_t PeakBytes() const { return peak_bytes_; }
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations_;
+    bytes_ += bytes;
+    peak_bytes_ = bytes_ > peak_bytes_ ? bytes_ : peak_bytes_;
+    return upstream_->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+    bytes_ -= bytes;
+    upstream_->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  std::pmr::memory_resource* upstream_;
+  std::size_t allocations_ = 0;
+  std::size_t bytes_ = 0;
+  std::size_t peak_bytes_ = 0;
+};
+
+}  // namespace generators
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "compact_nondeterministic_automaton.h"
+#include "finite_automata.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief A partition of the alphabet into classes of symbols that act alike
+ *
+ * \details Two symbols share a class when every state has the same
+ * successors by both of them, so the algorithms may run over the classes and
+ * the tables need one column per class. Classes are numbered 0..k-1 in the
+ * order of their smallest symbols. The class of a symbol is found in a byte
+ * map for the symbols 0..255 and by binary search in the sorted ranges of
+ * consecutive symbols of one class beyond it.
+ */
+class AlphabetPartition {
+ public:
+  static constexpr Symbol kBytes = 256;
+
+  AlphabetPartition();
+
+  /**
+   * \brief Builds the partition from the class of every symbol
+   *
+   * \param[in] symbols The sorted distinct symbols
+   * \param[in] classes The class of every symbol, the ids are renumbered
+   */
+  AlphabetPartition(std::vector<Symbol> symbols, const std::vector<std::uint32_t>& classes);
+
+  /**
+   * \brief Groups the columns with the same successors in every state
+   *
+   * \param[in] nfa The automaton, the symbol indices of the partition are its columns
+   */
+  explicit AlphabetPartition(const CompactNondeterministicAutomaton& nfa);
+
+  /**
+   * \brief Gives every symbol its own class
+   */
+  static AlphabetPartition Discrete(std::vector<Symbol> symbols);
+
+  /**
+   * \brief Gives the class of a symbol
+   *
+   * \return The class or ClassesCount() if the symbol is unknown
+   */
+  std::uint32_t Class(Symbol symbol) const {
+    if (0 <= symbol && symbol < kBytes) {
+      return bytes_[symbol];
+    }
+    auto it = std::upper_bound(ranges_.begin(), ranges_.end(), symbol,
+                               [](Symbol value, const Range& range) { return value < range.first; });
+    if (it == ranges_.begin() || (--it)->last < symbol) {
+      return static_cast<std::uint32_t>(ClassesCount());
+    }
+    return it->symbol_class;
+  }
+
+  /**
+   * \brief Gives the class of the symbol with the given index in the sorted alphabet
+   */
+  std::uint32_t ClassAt(std::size_t index) const { return classes_[index]; }
+
+  Symbol GetSymbol(std::size_t index) const { return symbols_[index]; }
+
+  /**
+   * \brief Gives the smallest symbol of a class
+   */
+  Symbol Representative(std::uint32_t symbol_class) const { return members_[members_begin_[symbol_class]]; }
+
+  template <typename Functor>
+  void ForeachSymbolOf(std::uint32_t symbol_class, Functor f) const {
+    for (auto i = members_begin_[symbol_class]; i != members_begin_[symbol_class + 1]; ++i) {
+      f(members_[i]);
+    }
+  }
+
+  std::size_t SymbolsCount() const { return symbols_.size(); }
+  std::size_t ClassesCount() const { return members_begin_.size() - 1; }
+
+  /**
+   * \brief Gives the bytes allocated by the lookup tables, not counting the object itself
+   */
+  std::size_t MemoryUsage() const;
+
+ private:
+  /// consecutive symbols first..last of one class
+  struct Range {
+    Symbol first;
+    Symbol last;
+    std::uint32_t symbol_class;
+  };
+
+  std::array<std::uint32_t, kBytes> bytes_;
+  std::vector<Range> ranges_;
+  std::vector<Symbol> symbols_;
+  std::vector<std::uint32_t> classes_;
+  std::vector<std::size_t> members_begin_;
+  std::vector<Symbol> members_;
+};
+
+/**
+ * \brief Groups equal items, numbering the groups in the order of their first items
+ *
+ * \param[in] count The number of items
+ * \param[in] hash  Gives the hash of an item by its index
+ * \param[in] equal Tells whether two items are equal by their indices
+ *
+ * \return The group of every item
+ */
+template <typename Hash, typename Equal>
+std::vector<std::uint32_t> GroupEqual(std::size_t count, Hash hash, Equal equal) {
+  std::vector<std::uint32_t> groups(count);
+  std::vector<std::uint32_t> firsts;
+  std::unordered_multimap<std::size_t, std::uint32_t> by_hash;
+  for (std::uint32_t item = 0; item != count; ++item) {
+    auto item_hash = hash(item);
+    auto [begin, end] = by_hash.equal_range(item_hash);
+    auto it = std::find_if(begin, end, [&](const auto& entry) { return equal(firsts[entry.second], item); });
+    if (it != end) {
+      groups[item] = it->second;
+      continue;
+    }
+    groups[item] = static_cast<std::uint32_t>(firsts.size());
+    by_hash.emplace(item_hash, groups[item]);
+    firsts.push_back(item);
+  }
+  return groups;
+}
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <utils/thread_pool.h>
+
+#include <cstdint>
+
+#include "compact_nondeterministic_automaton.h"
+#include "dense_deterministic_automaton.h"
+#include "finite_automata.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief Many words stored in one contiguous buffer
+ *
+ * \details Word i is [symbols + offsets[i], symbols + offsets[i + 1]), so
+ * offsets holds words_count + 1 elements.
+ */
+struct WordBatch {
+  const Symbol* symbols;
+  const std::size_t* offsets;
+  std::size_t words_count;
+};
+
+/**
+ * \brief Checks which words of a batch the automaton accepts
+ *
+ * \details The batch is split into chunks of whole result words, so threads
+ * never write to the same element of the result.
+ *
+ * \param[in]  dfa    The automaton
+ * \param[in]  batch  The words
+ * \param[out] result The bitmap of (words_count + 63) / 64 elements, bit i is set if word i is accepted
+ * \param[in]  pool   The threads to use or nullptr to run on the calling thread
+ */
+void AcceptsBatch(const DenseDeterministicAutomaton& dfa, const WordBatch& batch, std::uint64_t* result,
+                  utils::ThreadPool* pool = nullptr);
+
+/**
+ * \brief Checks which words of a batch the automaton accepts
+ *
+ * \details The start closure is computed once by the automaton and every
+ * thread reuses its state set buffers for all of its words.
+ *
+ * \param[in]  nfa    The automaton
+ * \param[in]  batch  The words
+ * \param[out] result The bitmap of (words_count + 63) / 64 elements, bit i is set if word i is accepted
+ * \param[in]  pool   The threads to use or nullptr to run on the calling thread
+ */
+void AcceptsBatch(const CompactNondeterministicAutomaton& nfa, const WordBatch& batch, std::uint64_t* result,
+                  utils::ThreadPool* pool = nullptr);
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "finite_automata.h"
+#include "nondeterministic_finite_automaton.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief Simulates a small nondeterministic automaton on machine words
+ *
+ * \details The active states are kept as a bit mask of Words 64-bit words.
+ * Every (state, symbol) pair stores the mask of its successors already
+ * closed under epsilon transitions, so one step is an OR of the masks of
+ * the active states.
+ */
+template <std::size_t Words>
+class BitParallelAutomaton {
+ public:
+  using Mask = std::array<std::uint64_t, Words>;
+
+  static constexpr std::size_t kMaxStates = Words * 64;
+
+  /**
+   * \brief Compiles the automaton
+   *
+   * \param[in] nfa The source automaton with at most kMaxStates states
+   */
+  explicit BitParallelAutomaton(const NondeterministicFiniteAutomaton& nfa);
+
+  /**
+   * \brief Checks whether the automaton accepts a given word
+   *
+   * \param[in] begin Begin of the word(source symbols)
+   * \param[in] end   End of the word(source symbols)
+   *
+   * \return Whether the word is accepted or not
+   */
+  bool Accepts(const Symbol* begin, const Symbol* end) const;
+
+  /**
+   * \brief Makes one step of the simulation
+   *
+   * \param[in,out] active The active states
+   * \param[in]     symbol The input symbol
+   *
+   * \return Whether some state is still active
+   */
+  bool Step(Mask& active, Symbol symbol) const;
+
+  const Mask& StartMask() const { return start_; }
+  bool IsAccepting(const Mask& active) const;
+
+  std::size_t StatesCount() const { return states_count_; }
+
+ private:
+  std::size_t Column(Symbol symbol) const {
+    auto it = std::lower_bound(symbols_.begin(), symbols_.end(), symbol);
+    if (it == symbols_.end() || *it != symbol) {
+      return symbols_.size();
+    }
+    return static_cast<std::size_t>(it - symbols_.begin());
+  }
+
+  static bool IsEmpty(const Mask& active);
+
+  std::vector<Symbol> symbols_;
+  std::vector<Mask> successors_;
+  Mask start_;
+  Mask final_;
+  std::size_t states_count_;
+};
+
+}  // namespace cppformlang::finite_automata
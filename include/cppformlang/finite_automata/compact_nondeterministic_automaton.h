@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "finite_automata.h"
+#include "finite_automation.h"
+#include "nondeterministic_finite_automaton.h"
+#include "nondeterministic_transitions.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief A read-only copy of an automaton with dense states and symbols
+ *
+ * \details States are numbered 0..n-1, symbols are mapped to ascending
+ * columns and the successors of every (state, column) are stored sorted and
+ * already closed under epsilon transitions. It is the common input of the
+ * algorithms that work on sets of states.
+ */
+class CompactNondeterministicAutomaton {
+ public:
+  explicit CompactNondeterministicAutomaton(const FiniteAutomaton<NondeterministicTransitions>& nfa);
+
+  /**
+   * \brief Gives the column of a symbol
+   *
+   * \return The column or SymbolsCount() if the symbol is unknown
+   */
+  std::size_t Column(Symbol symbol) const {
+    auto it = std::lower_bound(symbols_.begin(), symbols_.end(), symbol);
+    if (it == symbols_.end() || *it != symbol) {
+      return symbols_.size();
+    }
+    return static_cast<std::size_t>(it - symbols_.begin());
+  }
+
+  const std::uint32_t* SuccessorsBegin(std::uint32_t state, std::size_t column) const {
+    return successors_.data() + successors_begin_[state * symbols_.size() + column];
+  }
+  const std::uint32_t* SuccessorsEnd(std::uint32_t state, std::size_t column) const {
+    return successors_.data() + successors_begin_[state * symbols_.size() + column + 1];
+  }
+
+  /**
+   * \brief Gives the start states closed under epsilon transitions, sorted
+   */
+  const std::vector<std::uint32_t>& StartStates() const { return start_; }
+
+  bool IsStateFinal(std::uint32_t state) const { return final_[state]; }
+
+  /**
+   * \brief Gives the state of the source automaton
+   */
+  State GetState(std::uint32_t state) const { return states_[state]; }
+  Symbol GetSymbol(std::size_t column) const { return symbols_[column]; }
+
+  std::size_t StatesCount() const { return states_.size(); }
+  std::size_t SymbolsCount() const { return symbols_.size(); }
+
+ private:
+  std::vector<State> states_;
+  std::vector<Symbol> symbols_;
+  std::vector<std::size_t> successors_begin_;
+  std::vector<std::uint32_t> successors_;
+  std::vector<std::uint32_t> start_;
+  std::vector<bool> final_;
+};
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <utils/thread_pool.h>
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "finite_automata.h"
+#include "labeled_graph.h"
+#include "recursive_automation.h"
+#include "sparse_boolean_matrix.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief Finds for every box label the pairs of vertices connected by a path derived from it
+ *
+ * \details The tensor algorithm: the boxes are put side by side into one
+ * automaton of S states, the transitive closure of the Kronecker sum of its
+ * symbol matrices and the graph label matrices connects (start, u) to
+ * (final, v) of a box N when the path u..v is derived from N, which adds the
+ * edge u -N-> v to the graph. The closure is kept between the rounds and only
+ * extended by the Kronecker products of the new nonterminal edges, until no
+ * edge is added. Symbols without a box are terminals matched against the
+ * graph labels. S * VerticesCount() must fit in 32 bits.
+ *
+ * \param[in] rsm   The recursive automaton
+ * \param[in] graph The graph
+ * \param[in] pool  The threads to use or nullptr to run on the calling thread
+ *
+ * \return The VerticesCount() square matrix of every box label
+ */
+std::unordered_map<Symbol, SparseBooleanMatrix> ContextFreeReachability(const RecursiveAutomaton& rsm,
+                                                                         const LabeledGraph& graph,
+                                                                         utils::ThreadPool* pool = nullptr);
+
+/**
+ * \brief Finds the pairs of vertices connected by a path derived from the init label of the automaton
+ *
+ * \return The sorted (source, target) pairs
+ */
+std::vector<std::pair<State, State>> ContextFreePathQuery(const RecursiveAutomaton& rsm, const LabeledGraph& graph,
+                                                         utils::ThreadPool* pool = nullptr);
+
+}  // namespace cppformlang::finite_automata
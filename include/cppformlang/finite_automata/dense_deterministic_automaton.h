@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "alphabet_partition.h"
+#include "finite_automata.h"
+#include "nondeterministic_finite_automaton.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief An immutable deterministic automaton stored as a flat table
+ *
+ * \details States are numbered 0..n-1 in breadth-first order from the start
+ * state. The symbols that lead every state to the same state form a class
+ * of the alphabet partition, the classes are the columns 0..k-1 and the
+ * transition of state s by column c is stored at next[s * k + c]. Missing
+ * transitions lead to kDeadState.
+ */
+class DenseDeterministicAutomaton {
+ public:
+  static constexpr State kDeadState = std::numeric_limits<State>::max();
+
+  DenseDeterministicAutomaton();
+
+  /**
+   * \brief Compiles the automaton, determinizing it first if needed
+   *
+   * \param[in] nfa The source automaton
+   */
+  explicit DenseDeterministicAutomaton(const NondeterministicFiniteAutomaton& nfa);
+
+  /**
+   * \brief Builds the automaton from raw tables, equal columns are merged into one class
+   *
+   * \param[in] symbols      The sorted symbols, one per column
+   * \param[in] next         The transition table of size states * symbols
+   * \param[in] final_states The final states
+   * \param[in] start        The start state or kDeadState
+   */
+  DenseDeterministicAutomaton(std::vector<Symbol> symbols, std::vector<State> next,
+                              const std::vector<State>& final_states, State start);
+
+  /**
+   * \brief Builds the automaton from a table over classes, equal columns are merged
+   *
+   * \param[in] alphabet     The classes, one per column
+   * \param[in] next         The transition table of size states * classes
+   * \param[in] final_states The final states
+   * \param[in] start        The start state or kDeadState
+   */
+  DenseDeterministicAutomaton(AlphabetPartition alphabet, std::vector<State> next,
+                              const std::vector<State>& final_states, State start);
+
+  /**
+   * \brief Checks whether the automaton accepts a given word
+   *
+   * \param[in] begin Begin of the word(source symbols)
+   * \param[in] end   End of the word(source symbols)
+   *
+   * \return Whether the word is accepted or not
+   */
+  bool Accepts(const Symbol* begin, const Symbol* end) const;
+
+  /**
+   * \brief Gives the column of a symbol, that is its class
+   *
+   * \return The column or ColumnsCount() if the symbol is unknown
+   */
+  std::size_t Column(Symbol symbol) const { return alphabet_.Class(symbol); }
+
+  State Next(State state, std::size_t column) const { return next_[state * ColumnsCount() + column]; }
+
+  /**
+   * \brief Gives the raw transition table of StatesCount() * ColumnsCount() elements
+   */
+  const State* Transitions() const { return next_.data(); }
+
+  bool IsStateFinal(State state) const { return (final_[state / 64] >> (state % 64)) & 1U; }
+
+  State StartState() const { return start_; }
+
+  /**
+   * \brief Gives the symbol with the given index in the sorted alphabet, Column gives its column
+   */
+  Symbol GetSymbol(std::size_t index) const { return alphabet_.GetSymbol(index); }
+
+  const AlphabetPartition& Alphabet() const { return alphabet_; }
+
+  std::size_t StatesCount() const { return states_count_; }
+  std::size_t FinalStatesCount() const;
+  std::size_t SymbolsCount() const { return alphabet_.SymbolsCount(); }
+  std::size_t ColumnsCount() const { return alphabet_.ClassesCount(); }
+
+  /**
+   * \brief Gives the bytes allocated by the table, not counting the object itself
+   */
+  std::size_t MemoryUsage() const;
+
+  /**
+   * \brief Builds the minimal automaton of the same language
+   *
+   * \details Drops unreachable states, then merges equivalent ones by
+   * Hopcroft's partition refinement
+   */
+  DenseDeterministicAutomaton Minimize() const;
+
+  /**
+   * \brief Converts the table back to the general representation
+   *
+   * \return The automaton with states shifted by one, as ToDeterministic does
+   */
+  NondeterministicFiniteAutomaton ToNondeterministic() const;
+
+ private:
+  void MergeColumns();
+
+  AlphabetPartition alphabet_;
+  std::vector<State> next_;
+  std::vector<std::uint64_t> final_;
+  State start_;
+  std::size_t states_count_;
+};
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "finite_automata.h"
+#include "finite_automation.h"
+#include "nondeterministic_transitions.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief The epsilon closures of all states of an automaton
+ *
+ * \details The epsilon subgraph is condensed into strongly connected
+ * components first, so states on an epsilon cycle share one closure and
+ * every closure is computed once from the closures of its successor
+ * components. States without epsilon transitions are not stored, their
+ * closure is the state itself.
+ */
+class EpsilonClosureTable {
+ public:
+  explicit EpsilonClosureTable(const FiniteAutomaton<NondeterministicTransitions>& nfa);
+
+  /**
+   * \brief Calls the functor for every state of the epsilon closure
+   *
+   * \param[in] state The source state
+   * \param[in] f     The functor, the source state is passed too
+   */
+  template <typename Functor>
+  void ForeachInClosure(State state, Functor f) const {
+    auto it = components_.find(state);
+    if (it == components_.end()) {
+      f(state);
+      return;
+    }
+    for (auto i = offsets_[it->second], end = offsets_[it->second + 1]; i != end; ++i) {
+      f(closures_[i]);
+    }
+  }
+
+  std::size_t ClosureSize(State state) const;
+
+  /**
+   * \brief Gives the number of strongly connected components of the epsilon subgraph
+   */
+  std::size_t ComponentsCount() const { return offsets_.size() - 1; }
+
+ private:
+  std::unordered_map<State, std::uint32_t> components_;
+  std::vector<std::size_t> offsets_;
+  std::vector<State> closures_;
+};
+
+}  // namespace cppformlang::finite_automata
@@ -10,4 +10,14 @@ using State = std::uint32_t;
 
 inline constexpr Symbol kEpsilon = std::numeric_limits<Symbol>::min();
 
+/**
+ * \brief Asks an automaton to allocate from a monotonic arena it owns
+ *
+ * \details The memory is released at once when the automaton and the
+ * automata moved from it are destroyed, an automaton moved from keeps
+ * allocating from the arena. Copies of the automaton use the default memory
+ * resource.
+ */
+struct OwnArena {};
+
 }  // namespace cppformlang::finite_automata
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <memory_resource>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -14,6 +15,32 @@ namespace cppformlang::finite_automata {
 template <typename Transitions>
 class FiniteAutomaton : public Transitions {
  public:
+  FiniteAutomaton();
+
+  /**
+   * \brief Creates an empty automaton allocating from the given memory
+   *
+   * \param[in] resource The memory resource or OwnArena{} for an arena owned by the automaton
+   */
+  template <typename Resource>
+  explicit FiniteAutomaton(Resource resource)
+      : Transitions{resource},
+        states_{Transitions::GetResource()},
+        start_states_{Transitions::GetResource()},
+        final_states_{Transitions::GetResource()},
+        symbols_{Transitions::GetResource()} {}
+
+  FiniteAutomaton(const FiniteAutomaton& other);
+  FiniteAutomaton(FiniteAutomaton&& other) noexcept;
+
+  /**
+   * \brief Assigns the other automaton, the receiver keeps its memory resource
+   *
+   * \details Counts as a modification of the receiver
+   */
+  FiniteAutomaton& operator=(const FiniteAutomaton& other);
+  FiniteAutomaton& operator=(FiniteAutomaton&& other);
+
   /**
    * \brief Adds a transition to the finite automata
    *
@@ -37,6 +64,18 @@ class FiniteAutomaton : public Transitions {
    */
   bool RemoveTransition(State from, Symbol by, State to);
 
+  /**
+   * \brief Adds a state without transitions
+   *
+   * \details A new state holds an extra reference and is kept when the
+   * transitions added to it later are removed, so it can be a start or final
+   * state of its own. A known state is left as it is and is still removed
+   * with its marks when its last transition is removed.
+   *
+   * \return true if the state was added, false otherwise(was founded)
+   */
+  bool AddState(State state);
+
   bool SetStartState(State state, bool is_start);
   bool SetFinalState(State state, bool is_final);
 
@@ -49,6 +88,14 @@ class FiniteAutomaton : public Transitions {
   std::size_t FinalStatesCount() const;
   std::size_t SymbolsCount() const;
 
+  /**
+   * \brief Estimates the bytes allocated by the automaton, the object itself excluded
+   *
+   * \details The containers are hash tables of nodes, every node is counted
+   * with its element, next pointer and cached hash, every bucket as a pointer.
+   */
+  std::size_t MemoryUsage() const;
+
   template <typename Functor>
   void ForeachState(Functor f) const {
     for (auto& [state, _] : states_) {
@@ -77,10 +124,12 @@ class FiniteAutomaton : public Transitions {
   }
 
  protected:
-  std::unordered_map<State, std::uint32_t> states_;
-  std::unordered_set<State> start_states_;
-  std::unordered_set<State> final_states_;
-  std::unordered_map<Symbol, std::uint32_t> symbols_;
+  // grows with every change of the automaton, so data derived from it can tell whether it is stale
+  std::uint64_t modifications_ = 0;
+  std::pmr::unordered_map<State, std::uint32_t> states_;
+  std::pmr::unordered_set<State> start_states_;
+  std::pmr::unordered_set<State> final_states_;
+  std::pmr::unordered_map<Symbol, std::uint32_t> symbols_;
 };
 
 }  // namespace cppformlang::finite_automata
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dense_deterministic_automaton.h"
+#include "finite_automata.h"
+#include "nondeterministic_finite_automaton.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief A subset automaton kept up to date while its source automaton is edited
+ *
+ * \details Every subset state is indexed by the states it holds. A
+ * transition by a symbol from a state changes only the row of that symbol in
+ * the subsets that hold the state, so an edit recomputes these rows and
+ * builds the subsets they reach for the first time, the rest is kept. An
+ * epsilon transition changes the closures themselves and rebuilds the whole
+ * automaton.
+ *
+ * Subsets no longer reachable are kept until their number outgrows the
+ * reachable ones, then the automaton is compacted in one pass. The minimal
+ * automaton is computed on the first request after an edit and cached.
+ */
+class IncrementalDeterministicAutomaton {
+ public:
+  IncrementalDeterministicAutomaton();
+
+  explicit IncrementalDeterministicAutomaton(const NondeterministicFiniteAutomaton& nfa);
+
+  /**
+   * \brief Adds a transition to the source automaton and updates the subsets
+   *
+   * \return true if the transition was added, false if it was there already
+   */
+  bool AddTransition(State from, Symbol by, State to);
+
+  /**
+   * \brief Removes a transition from the source automaton and updates the subsets
+   *
+   * \details A state left without transitions is removed with its start and final marks
+   *
+   * \return true if the transition was removed, false if it was not found
+   */
+  bool RemoveTransition(State from, Symbol by, State to);
+
+  /**
+   * \return false if the state is unknown
+   */
+  bool SetStartState(State state, bool is_start);
+
+  /**
+   * \return false if the state is unknown
+   */
+  bool SetFinalState(State state, bool is_final);
+
+  /**
+   * \brief Checks whether the automaton accepts a given word
+   *
+   * \param[in] begin Begin of the word(source symbols)
+   * \param[in] end   End of the word(source symbols)
+   *
+   * \return Whether the word is accepted or not
+   */
+  bool Accepts(const Symbol* begin, const Symbol* end) const;
+
+  /**
+   * \brief Gives the minimal automaton, it is rebuilt only if the automaton was edited since the last call
+   */
+  const DenseDeterministicAutomaton& Minimal();
+
+  const NondeterministicFiniteAutomaton& Source() const { return nfa_; }
+
+  /**
+   * \brief Gives the number of subset states, unreachable ones included until the next compaction
+   */
+  std::size_t StatesCount() const { return subsets_.size(); }
+
+  /**
+   * \brief Gives the number of rows recomputed or built by the last edit
+   */
+  std::size_t LastUpdateSize() const { return last_update_size_; }
+
+ private:
+  static constexpr State kDead = DenseDeterministicAutomaton::kDeadState;
+
+  struct HashSubset {
+    std::size_t operator()(const std::vector<State>& value) const;
+  };
+
+  std::vector<State> Closure(std::vector<State> states) const;
+  std::vector<State> Move(State subset, Symbol symbol) const;
+  State Intern(std::vector<State> subset);
+  void BuildRows();
+  void SetRow(State subset, Symbol symbol, State to);
+  void UpdateRows(State state, Symbol symbol);
+  void UpdateFinal(State state);
+  void UpdateStart();
+  void Rebuild();
+  void MaybeCompact();
+  void Compact();
+  void Changed();
+
+  NondeterministicFiniteAutomaton nfa_;
+  // the transitions of every state sorted by symbol, epsilon first
+  std::unordered_map<State, std::vector<std::pair<Symbol, State>>> edges_;
+  std::size_t epsilons_count_;
+
+  std::vector<std::vector<State>> subsets_;
+  std::vector<std::vector<std::pair<Symbol, State>>> rows_;
+  std::vector<bool> final_;
+  std::unordered_map<std::vector<State>, State, HashSubset> ids_;
+  std::unordered_map<State, std::vector<State>> users_;
+  std::vector<State> to_build_;
+  State start_;
+
+  std::size_t compacted_size_;
+  std::size_t last_update_size_;
+  DenseDeterministicAutomaton minimal_;
+  bool minimal_valid_;
+};
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+#include "batch.h"
+#include "dense_deterministic_automaton.h"
+#include "finite_automata.h"
+
+namespace cppformlang::finite_automata {
+
+enum class InterleavedKernel {
+  kScalar,
+  kAvx2,
+};
+
+/**
+ * \brief Gives the fastest kernel supported by the running processor
+ */
+InterleavedKernel BestInterleavedKernel();
+
+/**
+ * \brief Checks words of a batch advancing several of them at once
+ *
+ * \details Eight words walk the automaton in lockstep, so the table loads of
+ * different words overlap. A lane that finishes its word takes the next one.
+ * The kAvx2 kernel loads the eight transitions with one gather, the scalar
+ * kernel issues eight independent loads. kAvx2 falls back to kScalar when
+ * it is not supported or the table does not fit 32-bit indices.
+ *
+ * \param[in]  dfa    The automaton
+ * \param[in]  batch  The words
+ * \param[in]  begin  The first word to check, a multiple of 64
+ * \param[in]  end    The end of the words to check
+ * \param[out] result The bitmap of the whole batch, only the elements of [begin, end) are written
+ * \param[in]  kernel The kernel to use
+ */
+void AcceptsInterleaved(const DenseDeterministicAutomaton& dfa, const WordBatch& batch, std::size_t begin,
+                        std::size_t end, std::uint64_t* result, InterleavedKernel kernel = BestInterleavedKernel());
+
+}  // namespace cppformlang::finite_automata
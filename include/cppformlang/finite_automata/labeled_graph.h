@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "finite_automata.h"
+
+namespace cppformlang::finite_automata {
+
+struct LabeledEdge {
+  State from;
+  Symbol label;
+  State to;
+};
+
+/**
+ * \brief An immutable directed graph with labeled edges
+ *
+ * \details Vertices are numbered 0..n-1 and labels are mapped to columns
+ * 0..k-1 in ascending order. The edges of a vertex are grouped into runs of
+ * one label, so a traversal only visits the labels the vertex has. Repeated
+ * edges are stored once.
+ */
+class LabeledGraph {
+ public:
+  struct Run {
+    std::uint32_t column;
+    std::size_t begin;
+  };
+
+  LabeledGraph();
+
+  /**
+   * \brief Builds the graph
+   *
+   * \param[in] vertices_count The number of vertices, every edge end must be less
+   * \param[in] edges          The edges in any order
+   */
+  LabeledGraph(std::size_t vertices_count, std::vector<LabeledEdge> edges);
+
+  /**
+   * \brief Calls f(column, begin, end) for every label of the edges leaving a vertex
+   *
+   * \details [begin, end) are the targets of the edges with that label, sorted
+   */
+  template <typename Functor>
+  void ForeachRun(State vertex, Functor f) const {
+    for (auto run = runs_begin_[vertex], end = runs_begin_[vertex + 1]; run != end; ++run) {
+      f(runs_[run].column, targets_.data() + runs_[run].begin, targets_.data() + runs_[run + 1].begin);
+    }
+  }
+
+  /**
+   * \brief Gives the column of a label
+   *
+   * \return The column or LabelsCount() if the label is unknown
+   */
+  std::size_t Column(Symbol label) const;
+  Symbol GetLabel(std::size_t column) const { return labels_[column]; }
+
+  std::size_t VerticesCount() const { return runs_begin_.size() - 1; }
+  std::size_t EdgesCount() const { return targets_.size(); }
+  std::size_t LabelsCount() const { return labels_.size(); }
+
+ private:
+  std::vector<Symbol> labels_;
+  std::vector<std::size_t> runs_begin_;
+  // one more run closes the last one
+  std::vector<Run> runs_;
+  std::vector<State> targets_;
+};
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "alphabet_partition.h"
+#include "compact_nondeterministic_automaton.h"
+#include "finite_automata.h"
+#include "nondeterministic_finite_automaton.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief A deterministic automaton built on the fly while matching
+ *
+ * \details A subset state and its transitions are created only when the
+ * input reaches them. The cache is bounded by a memory budget, when it is
+ * exceeded the whole cache is flushed and matching continues from the
+ * current subset. The cached rows have a column per class of the alphabet
+ * partition. Accepts fills the cache, so an object must not be shared
+ * between threads.
+ */
+class LazyDeterministicAutomaton {
+ public:
+  /**
+   * \brief Prepares the automaton, no subset state is built yet
+   *
+   * \param[in] nfa           The source automaton
+   * \param[in] memory_budget The approximate limit of the cache in bytes
+   */
+  explicit LazyDeterministicAutomaton(const NondeterministicFiniteAutomaton& nfa,
+                                      std::size_t memory_budget = std::size_t{1} << 20);
+
+  /**
+   * \brief Checks whether the automaton accepts a given word
+   *
+   * \param[in] begin Begin of the word(source symbols)
+   * \param[in] end   End of the word(source symbols)
+   *
+   * \return Whether the word is accepted or not
+   */
+  bool Accepts(const Symbol* begin, const Symbol* end);
+
+  std::size_t CachedStatesCount() const { return offsets_.size() - 1; }
+  std::size_t FlushesCount() const { return flushes_; }
+  std::size_t MemoryUsage() const { return memory_usage_; }
+
+ private:
+  static constexpr State kUnknown = std::numeric_limits<State>::max();
+  static constexpr State kDead = kUnknown - 1;
+
+  struct HashSubset {
+    std::size_t operator()(const std::vector<std::uint32_t>& value) const;
+  };
+
+  State Next(State state, std::uint32_t symbol_class);
+  State AddState(const std::vector<std::uint32_t>& subset);
+  void Flush();
+  std::size_t StateSize(std::size_t subset_size) const;
+
+  CompactNondeterministicAutomaton nfa_;
+  AlphabetPartition alphabet_;
+  std::vector<std::size_t> columns_;
+  std::size_t memory_budget_;
+  std::size_t memory_usage_;
+  std::size_t flushes_;
+  State start_;
+
+  std::unordered_map<std::vector<std::uint32_t>, State, HashSubset> ids_;
+  std::vector<std::size_t> offsets_;
+  std::vector<std::uint32_t> subsets_;
+  std::vector<State> next_;
+  std::vector<bool> final_;
+
+  std::vector<std::uint32_t> scratch_;
+  std::vector<std::uint32_t> stamp_;
+  std::uint32_t generation_;
+};
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "compact_nondeterministic_automaton.h"
+#include "dense_deterministic_automaton.h"
+#include "finite_automata.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief Matches a word that arrives in chunks
+ *
+ * \details Holds the current state of a deterministic automaton or the
+ * current state set of a nondeterministic one. All buffers are allocated by
+ * the constructor, so feeding input never allocates and the memory does not
+ * depend on the input size. The automaton must outlive the matcher.
+ */
+class Matcher {
+ public:
+  explicit Matcher(const DenseDeterministicAutomaton& dfa);
+  explicit Matcher(const CompactNondeterministicAutomaton& nfa);
+
+  /**
+   * \brief Continues the word with a chunk of symbols
+   *
+   * \param[in] begin Begin of the chunk
+   * \param[in] end   End of the chunk
+   *
+   * \return false if no state is active anymore, so the rest of the input can be skipped
+   */
+  bool Feed(const Symbol* begin, const Symbol* end);
+
+  /**
+   * \brief Whether the symbols fed since the last reset form an accepted word
+   */
+  bool IsAccepting() const;
+
+  /**
+   * \brief Whether the current state set is empty
+   *
+   * \details Then no continuation of the input can be accepted. A state that
+   * cannot reach a final state still counts as active, unless the automaton
+   * was trimmed, as a minimized one is.
+   */
+  bool IsDead() const;
+
+  /**
+   * \brief Starts a new word
+   */
+  void Reset();
+
+ private:
+  bool FeedNondeterministic(const Symbol* begin, const Symbol* end);
+
+  const DenseDeterministicAutomaton* dfa_;
+  const CompactNondeterministicAutomaton* nfa_;
+  State state_;
+  std::vector<std::uint32_t> current_;
+  std::vector<std::uint32_t> next_;
+  std::vector<std::uint32_t> stamp_;
+  std::uint32_t generation_;
+};
+
+}  // namespace cppformlang::finite_automata
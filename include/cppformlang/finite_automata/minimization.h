@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+
+#include "dense_deterministic_automaton.h"
+#include "finite_automata.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief Computes the coarsest stable partition by Hopcroft's algorithm
+ *
+ * \details The automaton is completed with an implicit dead state that has
+ * id StatesCount() and label 0. Runs in O(n * |classes| * log n) using an
+ * inverse transition index and flat partition arrays.
+ *
+ * \param[in] dfa    The automaton
+ * \param[in] labels The initial partition, a label for every state
+ *
+ * \return The block of every state followed by the block of the dead state
+ */
+std::vector<State> HopcroftPartition(const DenseDeterministicAutomaton& dfa, const std::vector<State>& labels);
+
+/**
+ * \brief Computes the same partition as HopcroftPartition by Moore's refinement
+ *
+ * \details Refines by successor signatures until the number of blocks is
+ * stable, O(n^2 * |classes|) in the worst case. Kept as a reference.
+ */
+std::vector<State> MoorePartition(const DenseDeterministicAutomaton& dfa, const std::vector<State>& labels);
+
+/**
+ * \brief Gives the final/non-final labels of the states
+ */
+std::vector<State> FinalLabels(const DenseDeterministicAutomaton& dfa);
+
+/**
+ * \brief Builds the quotient automaton of a partition
+ *
+ * \details The block of the dead state and the blocks unreachable from the
+ * start state are dropped, the rest is numbered in breadth-first order.
+ *
+ * \param[in]  dfa       The automaton
+ * \param[in]  blocks    The partition as returned by HopcroftPartition
+ * \param[out] state_ids If not nullptr, receives the new state of every state, kDeadState for dropped ones
+ *
+ * \return The quotient automaton
+ */
+DenseDeterministicAutomaton Quotient(const DenseDeterministicAutomaton& dfa, const std::vector<State>& blocks,
+                                     std::vector<State>* state_ids = nullptr);
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <variant>
+
+#include "bit_parallel_automaton.h"
+#include "finite_automata.h"
+#include "nondeterministic_finite_automaton.h"
+
+namespace cppformlang::finite_automata {
+
+enum class AcceptsEngine {
+  kGeneric,
+  kBitParallel,
+};
+
+/**
+ * \brief A read-only automaton with a selectable Accepts engine
+ *
+ * \details kBitParallel is used for automata with at most 256 states and
+ * falls back to the generic NondeterministicFiniteAutomaton::Accepts for
+ * larger ones.
+ */
+class NondeterministicAcceptor {
+ public:
+  explicit NondeterministicAcceptor(NondeterministicFiniteAutomaton nfa,
+                                    AcceptsEngine engine = AcceptsEngine::kBitParallel);
+
+  /**
+   * \brief Checks whether the automaton accepts a given word
+   *
+   * \param[in] begin Begin of the word(source symbols)
+   * \param[in] end   End of the word(source symbols)
+   *
+   * \return Whether the word is accepted or not
+   */
+  bool Accepts(const Symbol* begin, const Symbol* end) const;
+
+  /**
+   * \brief Gives the engine actually used after the fallback
+   */
+  AcceptsEngine Engine() const;
+
+  const NondeterministicFiniteAutomaton& Automaton() const { return nfa_; }
+
+ private:
+  NondeterministicFiniteAutomaton nfa_;
+  std::variant<std::monostate, BitParallelAutomaton<1>, BitParallelAutomaton<2>, BitParallelAutomaton<4>> engine_;
+};
+
+}  // namespace cppformlang::finite_automata
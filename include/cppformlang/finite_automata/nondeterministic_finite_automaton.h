@@ -1,10 +1,13 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
+#include "epsilon_closure_table.h"
 #include "finite_automata.h"
 #include "finite_automation.h"
 #include "nondeterministic_transitions.h"
@@ -18,10 +21,34 @@ class NondeterministicFiniteAutomaton : public FiniteAutomaton<NondeterministicT
  public:
   NondeterministicFiniteAutomaton();
 
-  explicit NondeterministicFiniteAutomaton(char c);
+  /**
+   * \brief Creates an empty automaton allocating from the given memory
+   *
+   * \param[in] resource The memory resource, it must outlive the automaton
+   */
+  explicit NondeterministicFiniteAutomaton(std::pmr::memory_resource* resource);
+
+  /**
+   * \brief Creates an empty automaton allocating from an arena it owns
+   */
+  explicit NondeterministicFiniteAutomaton(OwnArena arena);
 
+  explicit NondeterministicFiniteAutomaton(char c,
+                                           std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  /**
+   * \brief Builds the automaton of a regex
+   *
+   * \details The intermediate automata are built in a monotonic arena that
+   * is released at once, the result uses the default memory resource.
+   */
   static NondeterministicFiniteAutomaton FromRegex(const std::string& regex);
 
+  /**
+   * \brief Builds the automaton of a regex, all automata allocating from the given memory
+   */
+  static NondeterministicFiniteAutomaton FromRegex(const std::string& regex, std::pmr::memory_resource* resource);
+
   /**
    * \brief Makes the union of this and other object
    *
@@ -42,9 +69,22 @@ class NondeterministicFiniteAutomaton : public FiniteAutomaton<NondeterministicT
    */
   void KleeneStar();
 
+  /**
+   * \brief Builds the automaton of the reversed words
+   *
+   * \details Every transition is turned around and the start and final states swap
+   *
+   * \return The reversed automaton
+   */
+  NondeterministicFiniteAutomaton Reverse() const;
+
   /**
    * \brief Checks whether the nfa accepts a given word
    *
+   * \details The epsilon closures of all states are computed by the first call
+   * into an EpsilonClosureTable and kept until the automaton changes, so later
+   * calls do no closure work. Concurrent calls are safe.
+   *
    * \param[in] begin Begin of the word(source symbols)
    * \param[in] end   End of the word(source symbols)
    *
@@ -52,6 +92,40 @@ class NondeterministicFiniteAutomaton : public FiniteAutomaton<NondeterministicT
    */
   bool Accepts(const Symbol* begin, const Symbol* end) const;
 
+  /**
+   * \brief Checks whether the automaton accepts no word
+   *
+   * \details A breadth-first search from the start states that stops at the first final state
+   *
+   * \param[out] word If not nullptr and a word is accepted, receives a shortest one
+   */
+  bool IsEmpty(std::vector<Symbol>* word = nullptr) const;
+
+  /**
+   * \brief Checks whether every word accepted by this automaton is accepted by other
+   *
+   * \details The pairs of a state of this automaton and the set of states of
+   * other reached by the same word are explored breadth-first without building
+   * the subset automaton. A pair is dropped when another pair of the same state
+   * has a smaller set, so only an antichain of minimal sets is kept per state.
+   *
+   * \param[in]  other          The other automaton
+   * \param[out] counterexample If not nullptr and the check fails, receives a word accepted by this automaton only
+   */
+  bool IsSubsetOf(const NondeterministicFiniteAutomaton& other, std::vector<Symbol>* counterexample = nullptr) const;
+
+  /**
+   * \brief Checks whether both automata accept the same words
+   *
+   * \details Two deterministic automata are compared by the union-find
+   * algorithm of Hopcroft and Karp in near-linear time, otherwise the
+   * inclusion is checked both ways.
+   *
+   * \param[in]  other          The other automaton
+   * \param[out] counterexample If not nullptr and the check fails, receives a word accepted by one automaton only
+   */
+  bool IsEquivalent(const NondeterministicFiniteAutomaton& other, std::vector<Symbol>* counterexample = nullptr) const;
+
   /**
    * \brief Compute the epsilon closure of of state
    *
@@ -61,14 +135,50 @@ class NondeterministicFiniteAutomaton : public FiniteAutomaton<NondeterministicT
    */
   std::unordered_set<State> Eclose(State state) const;
 
+  /**
+   * \brief Builds an equivalent automaton without epsilon transitions
+   *
+   * \details Only states reachable from the start states are kept
+   *
+   * \return The epsilon-free automaton
+   */
+  NondeterministicFiniteAutomaton RemoveEpsilon() const;
+
   bool IsDeterministic() const;
 
   NondeterministicFiniteAutomaton ToDeterministic() const;
 
+  /**
+   * \brief Determinizes the automaton on several threads
+   *
+   * \details Worker threads expand subsets taken from work-stealing deques
+   * and deduplicate them in StateSetTables sharded by the subset hash, idle
+   * workers sleep until a subset is pushed. The states are renumbered in breadth-first order by
+   * ascending symbols at the end, so the result does not depend on the
+   * number of threads or their scheduling.
+   *
+   * \param[in] threads The number of worker threads, 0 for the hardware concurrency
+   *
+   * \return The deterministic automaton
+   */
+  NondeterministicFiniteAutomaton ToDeterministic(std::size_t threads) const;
+
   NondeterministicFiniteAutomaton Minimize() const;
 
  private:
-  std::unordered_set<State> GetNextStates(const std::unordered_set<State>& current_states, Symbol symbol) const;
+  // the epsilon closures with the count of modifications they were built at
+  struct CachedClosures {
+    std::uint64_t modifications;
+    EpsilonClosureTable table;
+  };
+
+  // the epsilon closures, built again when the automaton changed since the last call
+  std::shared_ptr<const EpsilonClosureTable> Closures() const;
+
+  void GetNextStates(const EpsilonClosureTable& closures, const std::unordered_set<State>& current_states,
+                     Symbol symbol, std::unordered_set<State>& next_states) const;
+
+  mutable std::shared_ptr<const CachedClosures> closures_;
 };
 
 }  // namespace cppformlang::finite_automata
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <memory_resource>
 #include <optional>
 #include <unordered_map>
 #include <unordered_set>
@@ -42,7 +44,27 @@ class NondeterministicTransitions {
    */
   std::size_t TransitionsCount() const;
 
+  /**
+   * \brief Estimates the bytes allocated by the transition tables
+   */
+  std::size_t MemoryUsage() const;
+
+  /**
+   * \brief Gives the memory resource all containers of the automaton allocate from
+   */
+  std::pmr::memory_resource* GetResource() const { return transitions_.get_allocator().resource(); }
+
  protected:
+  NondeterministicTransitions();
+  explicit NondeterministicTransitions(std::pmr::memory_resource* resource);
+  explicit NondeterministicTransitions(OwnArena);
+
+  NondeterministicTransitions(const NondeterministicTransitions& other);
+  NondeterministicTransitions(NondeterministicTransitions&& other) noexcept;
+  NondeterministicTransitions& operator=(const NondeterministicTransitions& other);
+  NondeterministicTransitions& operator=(NondeterministicTransitions&& other);
+  ~NondeterministicTransitions();
+
   /**
    * \brief Adds a new transition to the function
    *
@@ -80,10 +102,13 @@ class NondeterministicTransitions {
    *
    * \return The destination states or nullptr if it does not exists
    */
-  const std::unordered_set<State>* operator()(State from, Symbol by) const;
+  const std::pmr::unordered_set<State>* operator()(State from, Symbol by) const;
 
  private:
-  std::unordered_map<State, std::unordered_map<Symbol, std::unordered_set<State>>> transitions_;
+  // declared first, so the arena outlives every container allocated from it, a moved-from
+  // automaton keeps its containers bound to the arena and shares it with the new one
+  std::shared_ptr<std::pmr::monotonic_buffer_resource> arena_;
+  std::pmr::unordered_map<State, std::pmr::unordered_map<Symbol, std::pmr::unordered_set<State>>> transitions_;
 };
 
 }  // namespace cppformlang::finite_automata
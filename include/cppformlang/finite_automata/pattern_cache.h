@@ -0,0 +1,85 @@
+#pragma once
+
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "dense_deterministic_automaton.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief A thread-safe LRU cache of compiled regexes
+ *
+ * \details A regex is compiled to its minimal dense automaton through the
+ * position automaton of Regex. Entries are keyed by the canonical text of
+ * the regex, so regexes that differ only in parentheses or in implicit
+ * concatenation share one entry. The first request for a key compiles it
+ * outside the lock, requests that arrive meanwhile wait for the same
+ * result instead of compiling it again. The least recently used entries
+ * are dropped when the tables of all entries take more than the capacity.
+ */
+class PatternCache {
+ public:
+  using Automaton = std::shared_ptr<const DenseDeterministicAutomaton>;
+
+  struct Stats {
+    std::size_t hits;
+    std::size_t misses;
+    std::size_t evictions;
+    std::size_t entries;
+    std::size_t bytes;
+  };
+
+  /**
+   * \param[in] capacity The bytes the compiled automata may take
+   */
+  explicit PatternCache(std::size_t capacity);
+
+  /**
+   * \brief Gives the compiled automaton of a regex, compiling it on a miss
+   *
+   * \details A request that waits for the compilation of another thread is
+   * counted as a hit.
+   *
+   * \return The automaton or nullptr if the regex is malformed
+   */
+  Automaton Get(const std::string& regex);
+
+  Stats GetStats() const;
+
+  /**
+   * \brief Drops every entry, compilations in progress are finished for their waiters only
+   */
+  void Clear();
+
+ private:
+  struct Entry {
+    std::string key;
+    std::size_t id;
+    std::shared_future<Automaton> automaton;
+    std::size_t bytes;
+    bool ready;
+  };
+
+  /// moves the entry of the key to the front and gives its automaton, the mutex is held
+  std::shared_future<Automaton>* Find(const std::string& key);
+
+  /// drops entries from the back until the bytes fit, the mutex is held
+  void Evict();
+
+  const std::size_t capacity_;
+  mutable std::mutex mutex_;
+  std::list<Entry> lru_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> entries_;
+  std::size_t next_id_ = 0;
+  std::size_t bytes_ = 0;
+  std::size_t hits_ = 0;
+  std::size_t misses_ = 0;
+  std::size_t evictions_ = 0;
+};
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "dense_deterministic_automaton.h"
+#include "finite_automata.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief Many regexes compiled into one minimal deterministic automaton
+ *
+ * \details The position automata of the patterns are united and
+ * determinized together, a subset is tagged with the ids of the patterns
+ * whose final states it holds. Minimization starts from the partition by
+ * tag sets, so it merges only states that match the same patterns. One pass
+ * over a word then gives all the patterns that match it.
+ */
+class PatternSet {
+ public:
+  PatternSet();
+
+  /**
+   * \brief Compiles the patterns, the id of a pattern is its index
+   *
+   * \return The set or std::nullopt if a pattern is malformed
+   */
+  static std::optional<PatternSet> Compile(const std::vector<std::string>& patterns);
+
+  /**
+   * \brief Gives the patterns that match a given word
+   *
+   * \param[in] begin Begin of the word(source symbols)
+   * \param[in] end   End of the word(source symbols)
+   *
+   * \return The sorted ids of the matching patterns, valid while the set lives
+   */
+  const std::vector<std::uint32_t>& Match(const Symbol* begin, const Symbol* end) const;
+
+  /**
+   * \brief Gives the patterns matched when the automaton stops in a state, kDeadState included
+   */
+  const std::vector<std::uint32_t>& Tags(State state) const {
+    return tag_sets_[state == DenseDeterministicAutomaton::kDeadState ? 0 : state_tags_[state]];
+  }
+
+  const DenseDeterministicAutomaton& Automaton() const { return dfa_; }
+
+  std::size_t PatternsCount() const { return patterns_count_; }
+
+  /**
+   * \brief Gives the number of distinct tag sets, the empty one included
+   */
+  std::size_t TagSetsCount() const { return tag_sets_.size(); }
+
+ private:
+  DenseDeterministicAutomaton dfa_;
+  std::vector<std::uint32_t> state_tags_;
+  std::vector<std::vector<std::uint32_t>> tag_sets_;
+  std::size_t patterns_count_;
+};
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "finite_automata.h"
+#include "finite_automation.h"
+#include "nondeterministic_finite_automaton.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief Builds an automaton of the words accepted by both automata
+ *
+ * \details Only the pairs of states reachable from the start pairs are
+ * explored, they are numbered from 1 in breadth-first order.
+ *
+ * \return The product automaton
+ */
+template <typename Transitions>
+NondeterministicFiniteAutomaton Intersect(const FiniteAutomaton<Transitions>& left,
+                                          const FiniteAutomaton<Transitions>& right);
+
+/**
+ * \brief Builds an automaton of the words accepted by left but not by right
+ *
+ * \details Right is determinized on the fly, a state of the product is a
+ * state of left and a set of states of right. Only reachable pairs are built.
+ *
+ * \return The product automaton
+ */
+template <typename Transitions>
+NondeterministicFiniteAutomaton Difference(const FiniteAutomaton<Transitions>& left,
+                                           const FiniteAutomaton<Transitions>& right);
+
+/**
+ * \brief Builds a complete deterministic automaton of the words over the
+ * symbols of the automaton that it does not accept
+ *
+ * \details The automaton is determinized on the fly and completed with a
+ * final sink state, the empty set of states.
+ *
+ * \return The complement automaton
+ */
+template <typename Transitions>
+NondeterministicFiniteAutomaton Complement(const FiniteAutomaton<Transitions>& automaton);
+
+/**
+ * \brief Checks whether no word is accepted by both automata
+ *
+ * \details Explores the product without building it and stops at the first
+ * reachable pair of final states.
+ */
+template <typename Transitions>
+bool IsIntersectionEmpty(const FiniteAutomaton<Transitions>& left, const FiniteAutomaton<Transitions>& right);
+
+/**
+ * \brief Checks whether every word accepted by left is accepted by right
+ *
+ * \details Explores the difference without building it and stops at the
+ * first reachable final pair.
+ */
+template <typename Transitions>
+bool IsDifferenceEmpty(const FiniteAutomaton<Transitions>& left, const FiniteAutomaton<Transitions>& right);
+
+}  // namespace cppformlang::finite_automata
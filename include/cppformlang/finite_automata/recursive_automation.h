@@ -10,12 +10,33 @@ namespace cppformlang::finite_automata {
 class RecursiveAutomaton {
  public:
   void SetInitLabel(Symbol label);
+  Symbol GetInitLabel() const;
   bool AddBox(Symbol label, NondeterministicFiniteAutomaton dfa);
   const NondeterministicFiniteAutomaton* GetBox(Symbol label) const;
 
+  /**
+   * \brief Checks whether the word is derived from the init label
+   *
+   * \details The boxes are compiled on every call, a RecursiveRecognizer
+   * keeps them compiled for many words.
+   *
+   * \param[in] begin Begin of the word(source symbols)
+   * \param[in] end   End of the word(source symbols)
+   *
+   * \return Whether the word is accepted or not
+   */
+  bool Accepts(const Symbol* begin, const Symbol* end) const;
+
+  template <typename Functor>
+  void ForeachBox(Functor f) const {
+    for (auto& [label, box] : boxes_) {
+      f(label, box);
+    }
+  }
+
  private:
   std::unordered_map<Symbol, NondeterministicFiniteAutomaton> boxes_;
-  Symbol init_label_;
+  Symbol init_label_ = 0;
 };
 
 }  // namespace cppformlang::finite_automata
\ No newline at end of file
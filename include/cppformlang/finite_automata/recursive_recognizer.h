@@ -0,0 +1,118 @@
+#pragma once
+
+#include <utils/thread_pool.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "batch.h"
+#include "finite_automata.h"
+#include "recursive_automation.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief A recursive automaton compiled for word membership
+ *
+ * \details Every box is determinized into a dense table and the states of
+ * all boxes are numbered together. A transition by a box label is a call of
+ * that box, other symbols are terminals. The word is recognized by GLL: the
+ * descriptors (state, stack node, position) are processed position by
+ * position and deduplicated, the stack node of a box called at a position
+ * is shared by all callers and memoizes the positions the box returned at,
+ * so a late caller reuses them instead of parsing the box again. This is
+ * cubic in the word length in the worst case and close to linear for
+ * grammars that are nearly deterministic.
+ *
+ * The nullable boxes and the terminals every box can start with are
+ * computed once, a box is only called when the next symbol can start it
+ * or it is nullable.
+ */
+class RecursiveRecognizer {
+ public:
+  static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+  struct Call {
+    std::uint32_t box;
+    State to;
+  };
+
+  explicit RecursiveRecognizer(const RecursiveAutomaton& rsm);
+
+  /**
+   * \brief Checks whether the word is derived from the init label
+   *
+   * \param[in] begin Begin of the word(source symbols)
+   * \param[in] end   End of the word(source symbols)
+   *
+   * \return Whether the word is accepted or not
+   */
+  bool Accepts(const Symbol* begin, const Symbol* end) const;
+
+  /**
+   * \brief Gives the terminal index of a symbol or kNone if no box reads it
+   */
+  std::uint32_t Terminal(Symbol symbol) const;
+
+  /**
+   * \brief Gives the state reached by a terminal or kNone
+   */
+  State Next(State state, std::uint32_t terminal) const { return next_[state * terminals_.size() + terminal]; }
+
+  const Call* CallsBegin(State state) const { return calls_.data() + calls_offsets_[state]; }
+  const Call* CallsEnd(State state) const { return calls_.data() + calls_offsets_[state + 1]; }
+
+  bool IsStateFinal(State state) const { return final_[state]; }
+
+  /**
+   * \brief Gives the start state of a box or kNone if its language is empty
+   */
+  State StartState(std::uint32_t box) const { return start_[box]; }
+
+  bool IsNullable(std::uint32_t box) const { return nullable_[box]; }
+
+  /**
+   * \brief Tells whether a derivation of the box can start with the terminal
+   */
+  bool CanStart(std::uint32_t box, std::uint32_t terminal) const {
+    return (first_[box * first_words_ + terminal / 64] >> (terminal % 64)) & 1U;
+  }
+
+  /**
+   * \brief Gives the box of the init label or kNone if it has no box
+   */
+  std::uint32_t InitBox() const { return init_box_; }
+
+  std::size_t BoxesCount() const { return start_.size(); }
+  std::size_t StatesCount() const { return final_.size(); }
+  std::size_t TerminalsCount() const { return terminals_.size(); }
+
+ private:
+  std::vector<Symbol> terminals_;
+  std::vector<State> next_;
+  std::vector<std::size_t> calls_offsets_;
+  std::vector<Call> calls_;
+  std::vector<bool> final_;
+  std::vector<State> start_;
+  std::vector<bool> nullable_;
+  std::vector<std::uint64_t> first_;
+  std::size_t first_words_;
+  std::uint32_t init_box_;
+};
+
+/**
+ * \brief Checks which words of a batch are derived from the init label
+ *
+ * \details The compiled boxes and their first sets are shared by all words,
+ * every chunk of words reuses one set of stack and descriptor buffers.
+ *
+ * \param[in]  recognizer The compiled automaton
+ * \param[in]  batch      The words
+ * \param[out] result     The bitmap of (words_count + 63) / 64 elements, bit i is set if word i is accepted
+ * \param[in]  pool       The threads to use or nullptr to run on the calling thread
+ */
+void AcceptsBatch(const RecursiveRecognizer& recognizer, const WordBatch& batch, std::uint64_t* result,
+                  utils::ThreadPool* pool = nullptr);
+
+}  // namespace cppformlang::finite_automata
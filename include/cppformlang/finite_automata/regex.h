@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "finite_automata.h"
+#include "nondeterministic_finite_automaton.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief A regex parsed into a syntax tree
+ *
+ * \details The syntax is the one of NondeterministicFiniteAutomaton::FromRegex:
+ * '|' is the union, '+' the concatenation, '*' the Kleene star, parentheses
+ * group and '\' escapes the next character, every other character is a
+ * symbol. Adjacent operands are concatenated as if joined by '+'. The
+ * precedence is star, then concatenation, then union, binary operators
+ * group to the left.
+ *
+ * The nodes are stored in one vector, the children of a node come before
+ * it and the root is the last node. Every symbol node is a position, the
+ * positions are numbered from 1 in the order of the regex.
+ */
+class Regex {
+ public:
+  enum class Kind : std::uint8_t { kEmpty, kSymbol, kUnion, kConcatenation, kStar };
+
+  struct Node {
+    Kind kind;
+    Symbol symbol;
+    std::uint32_t left;
+    std::uint32_t right;
+    std::uint32_t position;
+  };
+
+  /**
+   * \brief Parses a regex
+   *
+   * \return The tree or nullopt if the regex is malformed, the empty regex is the empty language
+   */
+  static std::optional<Regex> Parse(const std::string& regex);
+
+  /**
+   * \brief Prints the tree back with the fewest parentheses, Parse(ToString()) gives the same tree
+   */
+  std::string ToString() const;
+
+  /**
+   * \brief Builds the position automaton of Glushkov
+   *
+   * \details The start state is 0 and position p is state p, a transition
+   * by the symbol of p enters p from the start state if p is in first() of
+   * the regex and from every position it follows. The follow relation is
+   * computed bottom up from the nullable, first and last sets of the nodes,
+   * in O(n * m) time for n nodes and m positions, and no epsilon transition
+   * is created.
+   */
+  NondeterministicFiniteAutomaton ToPositionAutomaton() const;
+
+  const Node& GetNode(std::uint32_t id) const { return nodes_[id]; }
+  std::uint32_t Root() const { return static_cast<std::uint32_t>(nodes_.size() - 1); }
+
+  std::size_t NodesCount() const { return nodes_.size(); }
+  std::size_t PositionsCount() const { return positions_count_; }
+
+ private:
+  Regex();
+
+  std::vector<Node> nodes_;
+  std::size_t positions_count_;
+};
+
+}  // namespace cppformlang::finite_automata
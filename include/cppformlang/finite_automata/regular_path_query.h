@@ -0,0 +1,43 @@
+#pragma once
+
+#include <utils/thread_pool.h>
+
+#include <utility>
+#include <vector>
+
+#include "compact_nondeterministic_automaton.h"
+#include "finite_automata.h"
+#include "labeled_graph.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief Finds the pairs of vertices connected by a path whose labels the automaton accepts
+ *
+ * \details Sources are processed 64 at a time by a breadth-first search
+ * over the product of the graph and the automaton, every (vertex, automaton
+ * state) holds the bitset of the sources that reached it, so a product edge
+ * is followed once for all of them. Groups of sources run in parallel, every
+ * thread keeps VerticesCount() * StatesCount() * 16 bytes of search state.
+ *
+ * \param[in] graph   The graph
+ * \param[in] query   The automaton over the labels of the graph
+ * \param[in] sources The start vertices
+ * \param[in] pool    The threads to use or nullptr to run on the calling thread
+ *
+ * \return The sorted (source, target) pairs
+ */
+std::vector<std::pair<State, State>> RegularPathQuery(const LabeledGraph& graph,
+                                                     const CompactNondeterministicAutomaton& query,
+                                                     const std::vector<State>& sources,
+                                                     utils::ThreadPool* pool = nullptr);
+
+/**
+ * \brief Finds the pairs of vertices connected by a path whose labels the automaton accepts,
+ * starting from every vertex
+ */
+std::vector<std::pair<State, State>> RegularPathQuery(const LabeledGraph& graph,
+                                                     const CompactNondeterministicAutomaton& query,
+                                                     utils::ThreadPool* pool = nullptr);
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dense_deterministic_automaton.h"
+#include "regex.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief The bytes [begin, end) of a text matched by a regex
+ */
+struct Match {
+  std::size_t begin;
+  std::size_t end;
+
+  bool operator==(const Match& other) const { return begin == other.begin && end == other.end; }
+};
+
+/**
+ * \brief Finds the matches of a regex inside a text
+ *
+ * \details The semantics is leftmost-longest: a match starts at the least
+ * position where some match starts and is the longest one from there. A byte
+ * of the text is the symbol of the same char, as in the regex.
+ *
+ * A text is scanned backward once by the minimal automaton of any* rev(R),
+ * the positions where it accepts are the ones a match starts at. From such
+ * a position the minimal automaton of R runs forward until it dies, and its
+ * last accepting position is the end of the match.
+ *
+ * A literal found in every match is extracted from the regex, a text without
+ * it is rejected by one substring search. When every match begins with the
+ * literal, the occurrences of the literal are the only candidate starts and
+ * the backward scan is skipped unless the forward runs from them get longer
+ * than the text.
+ */
+class Searcher {
+ public:
+  Searcher() = default;
+
+  explicit Searcher(const Regex& regex);
+
+  /**
+   * \brief Parses and compiles a regex
+   *
+   * \return The searcher or std::nullopt if the regex is malformed
+   */
+  static std::optional<Searcher> Compile(const std::string& regex);
+
+  /**
+   * \brief Finds the leftmost-longest match that starts at from or later
+   */
+  std::optional<Match> Search(std::string_view text, std::size_t from = 0) const;
+
+  /**
+   * \brief Finds the non-overlapping leftmost-longest matches from left to right
+   *
+   * \details The next search starts where a match ends, or one byte later after an empty match
+   */
+  std::vector<Match> FindAll(std::string_view text) const;
+
+  /**
+   * \brief Gives the literal every match contains, empty if there is none
+   */
+  const std::string& RequiredLiteral() const { return literal_; }
+
+  /**
+   * \brief Whether every match begins with RequiredLiteral()
+   */
+  bool IsLiteralPrefix() const { return literal_is_prefix_; }
+
+  const DenseDeterministicAutomaton& Forward() const { return forward_; }
+  const DenseDeterministicAutomaton& Reverse() const { return reverse_; }
+
+ private:
+  DenseDeterministicAutomaton forward_;
+  DenseDeterministicAutomaton reverse_;
+  std::string literal_;
+  bool literal_is_prefix_ = false;
+};
+
+}  // namespace cppformlang::finite_automata
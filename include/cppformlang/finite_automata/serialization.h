@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "dense_deterministic_automaton.h"
+#include "finite_automata.h"
+#include "nondeterministic_finite_automaton.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief The binary format of saved automata
+ *
+ * \details A file is a sequence of 32-bit little-endian words. It starts
+ * with kMagic, kVersion and the kind, followed by the kind specific header
+ * and tables:
+ * - kNondeterministic: transitions, start and final counts, then the sorted
+ *   (from, by, to) triples, the sorted start states and the sorted final states
+ * - kDenseDeterministic: states, symbols count and start state, then the
+ *   sorted symbols, the transition table of states * symbols words and the
+ *   final states as a bitset of (states + 31) / 32 words
+ */
+struct BinaryFormat {
+  enum class Kind : std::uint32_t { kNondeterministic = 1, kDenseDeterministic = 2 };
+
+  static constexpr std::uint32_t kMagic = 0x414C4643;  // "CFLA"
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr std::size_t kDenseHeaderWords = 6;
+};
+
+/**
+ * \brief Writes an automaton in the binary format
+ *
+ * \return Whether the stream is still good
+ */
+bool Save(const NondeterministicFiniteAutomaton& nfa, std::ostream& out);
+bool Save(const DenseDeterministicAutomaton& dfa, std::ostream& out);
+
+/**
+ * \brief Reads an automaton written by Save
+ *
+ * \return The automaton or nullopt if the stream does not hold one of this kind and version
+ */
+std::optional<NondeterministicFiniteAutomaton> LoadNondeterministic(std::istream& in);
+std::optional<DenseDeterministicAutomaton> LoadDenseDeterministic(std::istream& in);
+
+/**
+ * \brief A dense deterministic automaton over tables it does not own
+ *
+ * \details The tables have the layout of DenseDeterministicAutomaton with the
+ * final states packed in 32-bit words. Only the sizes are checked when the
+ * view is created, so that matching touches only the pages it needs, Verify
+ * checks every transition of an untrusted source.
+ */
+class DenseDeterministicView {
+ public:
+  DenseDeterministicView();
+
+  /**
+   * \brief Points the view into a buffer in the binary format
+   *
+   * \param[in] words The buffer in host byte order, it must outlive the view
+   * \param[in] size  The number of words in the buffer
+   *
+   * \return The view or nullopt if the buffer does not hold a dense automaton
+   */
+  static std::optional<DenseDeterministicView> FromWords(const std::uint32_t* words, std::size_t size);
+
+  /**
+   * \brief Checks that every transition leads to a state or to kDeadState
+   */
+  bool Verify() const;
+
+  bool Accepts(const Symbol* begin, const Symbol* end) const;
+
+  std::size_t Column(Symbol symbol) const {
+    auto it = std::lower_bound(symbols_, symbols_ + symbols_count_, symbol);
+    if (it == symbols_ + symbols_count_ || *it != symbol) {
+      return symbols_count_;
+    }
+    return static_cast<std::size_t>(it - symbols_);
+  }
+
+  State Next(State state, std::size_t column) const { return next_[state * symbols_count_ + column]; }
+  bool IsStateFinal(State state) const { return (final_[state / 32] >> (state % 32)) & 1U; }
+
+  State StartState() const { return start_; }
+  Symbol GetSymbol(std::size_t column) const { return symbols_[column]; }
+
+  std::size_t StatesCount() const { return states_count_; }
+  std::size_t SymbolsCount() const { return symbols_count_; }
+
+  /**
+   * \brief Copies the tables into an owning automaton
+   */
+  DenseDeterministicAutomaton ToDense() const;
+
+ private:
+  const Symbol* symbols_;
+  const State* next_;
+  const std::uint32_t* final_;
+  State start_;
+  std::size_t states_count_;
+  std::size_t symbols_count_;
+};
+
+/**
+ * \brief A saved dense automaton matched directly from the file
+ *
+ * \details On POSIX systems the file is mapped read-only and the tables are
+ * paged in on demand. Elsewhere, and on big-endian hosts where the words
+ * need to be swapped, the file is read into memory.
+ */
+class MappedDeterministicAutomaton {
+ public:
+  /**
+   * \brief Maps a file written by Save
+   *
+   * \details Every transition is checked once, so a corrupt file is rejected
+   * instead of being read out of bounds by Accepts.
+   *
+   * \return The automaton or nullopt if the file cannot be read or holds no valid dense automaton
+   */
+  static std::optional<MappedDeterministicAutomaton> Open(const std::string& path);
+
+  /**
+   * \brief Maps a trusted file written by Save without checking its transitions
+   *
+   * \details Only the header and the size are checked, a corrupt table leads
+   * to reads out of bounds.
+   *
+   * \return The automaton or nullopt if the file cannot be read or holds no dense automaton
+   */
+  static std::optional<MappedDeterministicAutomaton> OpenUnchecked(const std::string& path);
+
+  MappedDeterministicAutomaton(const MappedDeterministicAutomaton&) = delete;
+  MappedDeterministicAutomaton& operator=(const MappedDeterministicAutomaton&) = delete;
+  MappedDeterministicAutomaton(MappedDeterministicAutomaton&& other) noexcept;
+  MappedDeterministicAutomaton& operator=(MappedDeterministicAutomaton&& other) noexcept;
+  ~MappedDeterministicAutomaton();
+
+  bool Accepts(const Symbol* begin, const Symbol* end) const { return view_.Accepts(begin, end); }
+
+  const DenseDeterministicView& View() const { return view_; }
+
+  /**
+   * \brief Tells whether the tables are mapped from the file rather than read
+   */
+  bool IsMapped() const { return mapping_ != nullptr; }
+
+ private:
+  MappedDeterministicAutomaton();
+
+  static std::optional<MappedDeterministicAutomaton> Open(const std::string& path, bool verify);
+
+  void Unmap();
+
+  void* mapping_;
+  std::size_t mapping_size_;
+  std::vector<std::uint32_t> buffer_;
+  DenseDeterministicView view_;
+};
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <utils/thread_pool.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief An immutable boolean matrix in compressed sparse rows
+ *
+ * \details Row r holds the sorted column indices [RowBegin(r), RowEnd(r)).
+ * The compressed sparse columns of a matrix are the rows of its Transpose().
+ * The operations build a new matrix row by row, rows are split between the
+ * threads of a pool when one is given.
+ */
+class SparseBooleanMatrix {
+ public:
+  SparseBooleanMatrix();
+
+  /**
+   * \brief Creates a matrix without entries
+   */
+  SparseBooleanMatrix(std::size_t rows, std::size_t columns);
+
+  /**
+   * \brief Creates a matrix from (row, column) pairs in any order, repeated pairs are stored once
+   */
+  SparseBooleanMatrix(std::size_t rows, std::size_t columns,
+                      std::vector<std::pair<std::uint32_t, std::uint32_t>> entries);
+
+  static SparseBooleanMatrix Identity(std::size_t size);
+
+  bool Get(std::size_t row, std::size_t column) const;
+
+  const std::uint32_t* RowBegin(std::size_t row) const { return columns_.data() + offsets_[row]; }
+  const std::uint32_t* RowEnd(std::size_t row) const { return columns_.data() + offsets_[row + 1]; }
+
+  template <typename Functor>
+  void ForeachEntry(Functor f) const {
+    for (std::size_t row = 0; row + 1 < offsets_.size(); ++row) {
+      for (auto column = RowBegin(row), end = RowEnd(row); column != end; ++column) {
+        f(static_cast<std::uint32_t>(row), *column);
+      }
+    }
+  }
+
+  std::size_t Rows() const { return offsets_.size() - 1; }
+  std::size_t Columns() const { return columns_count_; }
+  std::size_t NonZeros() const { return columns_.size(); }
+
+  SparseBooleanMatrix Transpose() const;
+
+  bool operator==(const SparseBooleanMatrix& other) const;
+  bool operator!=(const SparseBooleanMatrix& other) const { return !(*this == other); }
+
+ private:
+  friend SparseBooleanMatrix Add(const SparseBooleanMatrix&, const SparseBooleanMatrix&, utils::ThreadPool*);
+  friend SparseBooleanMatrix Subtract(const SparseBooleanMatrix&, const SparseBooleanMatrix&, utils::ThreadPool*);
+  friend SparseBooleanMatrix Multiply(const SparseBooleanMatrix&, const SparseBooleanMatrix&, utils::ThreadPool*);
+  friend SparseBooleanMatrix Kronecker(const SparseBooleanMatrix&, const SparseBooleanMatrix&, utils::ThreadPool*);
+
+  SparseBooleanMatrix(std::size_t columns, std::vector<std::size_t> offsets, std::vector<std::uint32_t> indices);
+
+  /// builds a matrix from the sorted columns that row(r, worker, out) appends for every row r
+  template <typename RowFunctor>
+  static SparseBooleanMatrix BuildRows(std::size_t rows, std::size_t columns, utils::ThreadPool* pool,
+                                       RowFunctor row);
+
+  std::size_t columns_count_;
+  std::vector<std::size_t> offsets_;
+  std::vector<std::uint32_t> columns_;
+};
+
+/**
+ * \brief Gives the element-wise or of two matrices of the same shape
+ */
+SparseBooleanMatrix Add(const SparseBooleanMatrix& lhs, const SparseBooleanMatrix& rhs,
+                        utils::ThreadPool* pool = nullptr);
+
+/**
+ * \brief Gives the entries of lhs that are not in rhs, the matrices have the same shape
+ */
+SparseBooleanMatrix Subtract(const SparseBooleanMatrix& lhs, const SparseBooleanMatrix& rhs,
+                             utils::ThreadPool* pool = nullptr);
+
+/**
+ * \brief Gives the boolean product, lhs.Columns() == rhs.Rows()
+ *
+ * \details Gustavson's row by row algorithm, every thread marks the columns
+ * of its current row in an array of rhs.Columns() elements.
+ */
+SparseBooleanMatrix Multiply(const SparseBooleanMatrix& lhs, const SparseBooleanMatrix& rhs,
+                             utils::ThreadPool* pool = nullptr);
+
+/**
+ * \brief Gives the Kronecker product
+ *
+ * \details Entry (i * rhs.Rows() + k, j * rhs.Columns() + l) is set if both
+ * lhs(i, j) and rhs(k, l) are.
+ */
+SparseBooleanMatrix Kronecker(const SparseBooleanMatrix& lhs, const SparseBooleanMatrix& rhs,
+                              utils::ThreadPool* pool = nullptr);
+
+}  // namespace cppformlang::finite_automata
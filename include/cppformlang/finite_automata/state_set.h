@@ -0,0 +1,145 @@
+#pragma once
+
+#include <utils/bits.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "finite_automata.h"
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief A set of dense state ids 0..universe-1 used while building subsets
+ *
+ * \details Membership is always kept in a bitset over the universe, so an
+ * insert is O(1). Small sets also list their states in the order of
+ * insertion, a set with more than universe / 32 elements drops the list and
+ * is stored by its bitset, whichever is smaller. The representation depends
+ * only on the size, so equal sets are stored the same way. The hash is the
+ * sum of the mixed element hashes and is updated on every insert, it does
+ * not depend on the order of insertion.
+ */
+class StateSet {
+ public:
+  explicit StateSet(std::size_t universe);
+
+  /**
+   * \brief Adds a state
+   *
+   * \return true if the state was not in the set
+   */
+  bool Insert(std::uint32_t state);
+
+  bool Contains(std::uint32_t state) const;
+
+  /**
+   * \brief Removes all states, the memory is kept for the next set
+   *
+   * \details O(size) for a small set, O(universe / 64) for a dense one
+   */
+  void Clear();
+
+  /**
+   * \brief Calls f for every state, in the order of insertion for a small set and ascending for a dense one
+   */
+  template <typename Functor>
+  void ForeachState(Functor f) const {
+    if (!dense_) {
+      for (auto state : states_) {
+        f(state);
+      }
+      return;
+    }
+    for (std::size_t word = 0; word != bits_.size(); ++word) {
+      utils::foreach_bit(bits_[word], [&](unsigned bit) { f(static_cast<std::uint32_t>(word * 64 + bit)); });
+    }
+  }
+
+  std::size_t Size() const { return size_; }
+  bool Empty() const { return size_ == 0; }
+  std::size_t Hash() const { return hash_; }
+  std::size_t Universe() const { return universe_; }
+  bool IsDense() const { return dense_; }
+
+  /**
+   * \brief Gives the states of a small set in the order of insertion
+   */
+  const std::vector<std::uint32_t>& States() const { return states_; }
+  const std::vector<std::uint64_t>& Bits() const { return bits_; }
+
+  static std::size_t HashState(std::uint32_t state);
+
+ private:
+  std::size_t universe_;
+  std::size_t size_;
+  std::size_t hash_;
+  bool dense_;
+  std::vector<std::uint32_t> states_;
+  std::vector<std::uint64_t> bits_;
+};
+
+/**
+ * \brief Interns state sets into one arena and numbers them
+ *
+ * \details Sets are stored back to back in a single buffer, small sets as
+ * their elements, sorted once when the set is added, and dense ones as their
+ * bitset, and found again through an open addressing table of ids. No memory
+ * is allocated per set.
+ */
+class StateSetTable {
+ public:
+  explicit StateSetTable(std::size_t universe);
+
+  /**
+   * \brief Finds the set or adds a copy of it
+   *
+   * \return The id of the set and whether it was added now
+   */
+  std::pair<std::uint32_t, bool> Intern(const StateSet& set);
+
+  template <typename Functor>
+  void ForeachState(std::uint32_t id, Functor f) const {
+    auto& entry = entries_[id];
+    const auto* data = arena_.data() + entry.offset;
+    if (!entry.dense) {
+      for (std::size_t i = 0; i != entry.size; ++i) {
+        f(data[i]);
+      }
+      return;
+    }
+    for (std::size_t word = 0; word != DenseWords(); ++word) {
+      auto bits = std::uint64_t{data[2 * word]} | std::uint64_t{data[2 * word + 1]} << 32;
+      utils::foreach_bit(bits, [&](unsigned bit) { f(static_cast<std::uint32_t>(word * 64 + bit)); });
+    }
+  }
+
+  std::size_t SetSize(std::uint32_t id) const { return entries_[id].size; }
+  std::size_t Size() const { return entries_.size(); }
+
+  /**
+   * \brief Gives the number of bytes held by the table
+   */
+  std::size_t MemoryUsage() const;
+
+ private:
+  struct Entry {
+    std::size_t offset;
+    std::size_t hash;
+    std::uint32_t size;
+    bool dense;
+  };
+
+  static constexpr auto kEmpty = ~std::uint32_t{0};
+
+  std::size_t DenseWords() const { return (universe_ + 63) / 64; }
+  bool Equals(const Entry& entry, const StateSet& set) const;
+  void Grow();
+
+  std::size_t universe_;
+  std::vector<std::uint32_t> arena_;
+  std::vector<Entry> entries_;
+  std::vector<std::uint32_t> slots_;
+};
+
+}  // namespace cppformlang::finite_automata
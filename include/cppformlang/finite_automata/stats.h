@@ -0,0 +1,134 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#ifndef CPPFORMLANG_ENABLE_STATS
+#define CPPFORMLANG_ENABLE_STATS 0
+#endif
+
+namespace cppformlang::finite_automata {
+
+/**
+ * \brief Whether the algorithms record their statistics
+ *
+ * \details Set by defining CPPFORMLANG_ENABLE_STATS=1, the CMake option of
+ * the same name does it for the library and its users. When it is off the
+ * recording functions are empty and inlined away.
+ */
+inline constexpr bool kStatsEnabled = CPPFORMLANG_ENABLE_STATS != 0;
+
+enum class Phase : std::uint8_t { kToDeterministic, kMinimize, kAccepts };
+
+inline constexpr std::size_t kPhasesCount = 3;
+
+/**
+ * \brief The counters of the algorithms run by one thread
+ *
+ * \details Closures are counted both when Eclose is called and when an
+ * epsilon closure table computes the closure of a component. The probes are
+ * the slots visited by a lookup in the subset table of a subset
+ * construction. The peak bytes are the largest MemoryUsage() of a subset
+ * table and its deterministic automaton at the end of a construction.
+ */
+struct AlgorithmStats {
+  std::uint64_t subset_states = 0;
+  std::uint64_t closures = 0;
+  std::uint64_t closure_states = 0;
+  std::uint64_t max_closure_size = 0;
+  std::uint64_t subset_lookups = 0;
+  std::uint64_t subset_probes = 0;
+  std::uint64_t max_probe_length = 0;
+  std::uint64_t peak_bytes = 0;
+  std::uint64_t phase_calls[kPhasesCount] = {};
+  std::chrono::nanoseconds phase_time[kPhasesCount] = {};
+};
+
+/**
+ * \brief Gives the counters of the calling thread, they stay zero when the statistics are disabled
+ *
+ * \details The workers of a parallel algorithm count in their own threads.
+ */
+AlgorithmStats& ThreadStats();
+
+void ResetThreadStats();
+
+/**
+ * \brief Is called with the duration of every phase on the thread that ran it
+ */
+using TraceSink = void (*)(Phase phase, std::chrono::nanoseconds duration);
+
+/**
+ * \brief Sets the function receiving the phases or nullptr for none
+ */
+void SetTraceSink(TraceSink sink);
+
+TraceSink GetTraceSink();
+
+namespace stats {
+
+inline void RecordSubsetState() {
+  if constexpr (kStatsEnabled) {
+    ++ThreadStats().subset_states;
+  }
+}
+
+inline void RecordClosure(std::size_t size) {
+  if constexpr (kStatsEnabled) {
+    auto& stats = ThreadStats();
+    ++stats.closures;
+    stats.closure_states += size;
+    stats.max_closure_size = stats.max_closure_size < size ? size : stats.max_closure_size;
+  }
+}
+
+inline void RecordProbes(std::size_t length) {
+  if constexpr (kStatsEnabled) {
+    auto& stats = ThreadStats();
+    ++stats.subset_lookups;
+    stats.subset_probes += length;
+    stats.max_probe_length = stats.max_probe_length < length ? length : stats.max_probe_length;
+  }
+}
+
+inline void RecordBytes(std::size_t bytes) {
+  if constexpr (kStatsEnabled) {
+    auto& stats = ThreadStats();
+    stats.peak_bytes = stats.peak_bytes < bytes ? bytes : stats.peak_bytes;
+  }
+}
+
+/**
+ * \brief Times a phase from its construction to its destruction
+ */
+class ScopedPhase {
+ public:
+  explicit ScopedPhase(Phase phase) : phase_{phase} {
+    if constexpr (kStatsEnabled) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ScopedPhase(const ScopedPhase&) = delete;
+  ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+  ~ScopedPhase() {
+    if constexpr (kStatsEnabled) {
+      auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+      auto& stats = ThreadStats();
+      ++stats.phase_calls[static_cast<std::size_t>(phase_)];
+      stats.phase_time[static_cast<std::size_t>(phase_)] += duration;
+      if (auto sink = GetTraceSink()) {
+        sink(phase_, duration);
+      }
+    }
+  }
+
+ private:
+  [[maybe_unused]] Phase phase_;
+  [[maybe_unused]] std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace stats
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace utils {
+
+/// index of the lowest set bit, value must not be zero
+inline unsigned count_trailing_zeros(std::uint64_t value) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward64(&index, value);
+  return static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+}
+
+/// calls f with the index of every set bit in ascending order
+template <typename Functor>
+void foreach_bit(std::uint64_t value, Functor f) {
+  while (value != 0) {
+    f(count_trailing_zeros(value));
+    value &= value - 1;
+  }
+}
+
+}  // namespace utils
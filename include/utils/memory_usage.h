@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+
+namespace utils {
+
+/**
+ * estimates the bytes allocated by an unordered container without the memory of its elements' own members:
+ * a node holds the next pointer, the element and its cached hash, and the buckets are one pointer each
+ */
+template <typename Container>
+std::size_t hash_container_memory(const Container& container) {
+  constexpr auto kAlignment = alignof(std::max_align_t);
+  constexpr auto kNodeBytes = sizeof(void*) + sizeof(typename Container::value_type) + sizeof(std::size_t);
+  constexpr auto kNode = (kNodeBytes + kAlignment - 1) / kAlignment * kAlignment;
+  return container.size() * kNode + container.bucket_count() * sizeof(void*);
+}
+
+}  // namespace utils
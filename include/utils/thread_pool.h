@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+
+/// a fixed set of worker threads that run one parallel loop at a time
+class ThreadPool {
+ public:
+  /// threads is the total number of threads including the caller, 0 for the hardware concurrency
+  explicit ThreadPool(std::size_t threads = 0) {
+    if (threads == 0) {
+      threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    for (std::size_t worker = 1; worker < threads; ++worker) {
+      workers_.emplace_back([this, worker] { Work(worker); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard lock{mutex_};
+      stop_ = true;
+    }
+    start_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  std::size_t ThreadsCount() const { return workers_.size() + 1; }
+
+  /**
+   * calls f(begin, end, thread) for chunks of [0, count) of at most chunk indices,
+   * every chunk but the last starts at a multiple of chunk, returns when all are done
+   */
+  template <typename Functor>
+  void ParallelFor(std::size_t count, std::size_t chunk, Functor f) {
+    if (count == 0) {
+      return;
+    }
+    std::function<void(std::size_t, std::size_t, std::size_t)> task = std::ref(f);
+    {
+      std::lock_guard lock{mutex_};
+      task_ = &task;
+      count_ = count;
+      chunk_ = std::max<std::size_t>(chunk, 1);
+      next_.store(0);
+      running_ = workers_.size();
+      ++generation_;
+    }
+    start_.notify_all();
+    RunChunks(0);
+    std::unique_lock lock{mutex_};
+    done_.wait(lock, [this] { return running_ == 0; });
+    task_ = nullptr;
+  }
+
+ private:
+  void Work(std::size_t worker) {
+    std::size_t seen = 0;
+    while (true) {
+      {
+        std::unique_lock lock{mutex_};
+        start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_) {
+          return;
+        }
+        seen = generation_;
+      }
+      RunChunks(worker);
+      std::lock_guard lock{mutex_};
+      if (--running_ == 0) {
+        done_.notify_one();
+      }
+    }
+  }
+
+  void RunChunks(std::size_t worker) {
+    while (true) {
+      auto begin = next_.fetch_add(chunk_);
+      if (begin >= count_) {
+        return;
+      }
+      (*task_)(begin, std::min(begin + chunk_, count_), worker);
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  bool stop_ = false;
+  std::size_t generation_ = 0;
+  std::size_t running_ = 0;
+
+  std::function<void(std::size_t, std::size_t, std::size_t)>* task_ = nullptr;
+  std::size_t count_ = 0;
+  std::size_t chunk_ = 1;
+  std::atomic<std::size_t> next_{0};
+};
+
+}  // namespace utils
@@ -0,0 +1,98 @@
+#include <cppformlang/finite_automata/alphabet_partition.h>
+#include <utils/hash.h>
+
+#include <cassert>
+#include <numeric>
+#include <utility>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+std::vector<Symbol> Symbols(const CompactNondeterministicAutomaton& nfa) {
+  std::vector<Symbol> symbols(nfa.SymbolsCount());
+  for (std::size_t column = 0; column != symbols.size(); ++column) {
+    symbols[column] = nfa.GetSymbol(column);
+  }
+  return symbols;
+}
+
+/// columns are equal when every state has the same successors in both
+std::vector<std::uint32_t> ColumnClasses(const CompactNondeterministicAutomaton& nfa) {
+  const auto states = static_cast<std::uint32_t>(nfa.StatesCount());
+  auto hash = [&](std::uint32_t column) {
+    std::size_t seed = 0;
+    for (std::uint32_t state = 0; state != states; ++state) {
+      auto begin = nfa.SuccessorsBegin(state, column);
+      auto end = nfa.SuccessorsEnd(state, column);
+      utils::hash_combine(seed, utils::hash_range<std::uint32_t>(begin, end));
+    }
+    return seed;
+  };
+  auto equal = [&](std::uint32_t left, std::uint32_t right) {
+    for (std::uint32_t state = 0; state != states; ++state) {
+      if (!std::equal(nfa.SuccessorsBegin(state, left), nfa.SuccessorsEnd(state, left),
+                      nfa.SuccessorsBegin(state, right), nfa.SuccessorsEnd(state, right))) {
+        return false;
+      }
+    }
+    return true;
+  };
+  return GroupEqual(nfa.SymbolsCount(), hash, equal);
+}
+
+}  // namespace
+
+AlphabetPartition::AlphabetPartition() : members_begin_{0} { bytes_.fill(0); }
+
+AlphabetPartition::AlphabetPartition(std::vector<Symbol> symbols, const std::vector<std::uint32_t>& classes)
+    : symbols_{std::move(symbols)}, classes_(symbols_.size()) {
+  assert(std::is_sorted(symbols_.begin(), symbols_.end()));
+  assert(classes.size() == symbols_.size());
+  // numbering by first occurrence orders the classes by their smallest symbols
+  std::unordered_map<std::uint32_t, std::uint32_t> ids;
+  for (std::size_t i = 0; i != symbols_.size(); ++i) {
+    classes_[i] = ids.emplace(classes[i], static_cast<std::uint32_t>(ids.size())).first->second;
+  }
+  const auto count = static_cast<std::uint32_t>(ids.size());
+
+  members_begin_.assign(count + 1, 0);
+  for (auto symbol_class : classes_) {
+    ++members_begin_[symbol_class + 1];
+  }
+  std::partial_sum(members_begin_.begin(), members_begin_.end(), members_begin_.begin());
+  members_.resize(symbols_.size());
+  auto fill = members_begin_;
+  for (std::size_t i = 0; i != symbols_.size(); ++i) {
+    members_[fill[classes_[i]]++] = symbols_[i];
+  }
+
+  bytes_.fill(count);
+  for (std::size_t i = 0; i != symbols_.size(); ++i) {
+    auto symbol = symbols_[i];
+    if (0 <= symbol && symbol < kBytes) {
+      bytes_[symbol] = classes_[i];
+    } else if (!ranges_.empty() && ranges_.back().last + 1 == symbol && ranges_.back().symbol_class == classes_[i]) {
+      ranges_.back().last = symbol;
+    } else {
+      ranges_.push_back(Range{symbol, symbol, classes_[i]});
+    }
+  }
+}
+
+AlphabetPartition::AlphabetPartition(const CompactNondeterministicAutomaton& nfa)
+    : AlphabetPartition{Symbols(nfa), ColumnClasses(nfa)} {}
+
+AlphabetPartition AlphabetPartition::Discrete(std::vector<Symbol> symbols) {
+  std::vector<std::uint32_t> classes(symbols.size());
+  std::iota(classes.begin(), classes.end(), 0);
+  return AlphabetPartition{std::move(symbols), classes};
+}
+
+std::size_t AlphabetPartition::MemoryUsage() const {
+  return ranges_.capacity() * sizeof(Range) + symbols_.capacity() * sizeof(Symbol) +
+         classes_.capacity() * sizeof(std::uint32_t) + members_begin_.capacity() * sizeof(std::size_t) +
+         members_.capacity() * sizeof(Symbol);
+}
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,52 @@
+#include <cppformlang/finite_automata/batch.h>
+#include <cppformlang/finite_automata/interleaved_matcher.h>
+#include <cppformlang/finite_automata/matcher.h>
+
+#include <algorithm>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+constexpr std::size_t kChunkWords = 64 * 64;
+
+/// runs run(begin, end) over chunks of the batch, chunks cover whole bitmap elements
+template <typename Run>
+void RunChunks(const WordBatch& batch, utils::ThreadPool* pool, Run run) {
+  if (pool == nullptr || pool->ThreadsCount() == 1) {
+    run(0, batch.words_count);
+    return;
+  }
+  pool->ParallelFor(batch.words_count, kChunkWords, [&](std::size_t begin, std::size_t end, std::size_t) {
+    run(begin, end);
+  });
+}
+
+}  // namespace
+
+void AcceptsBatch(const DenseDeterministicAutomaton& dfa, const WordBatch& batch, std::uint64_t* result,
+                  utils::ThreadPool* pool) {
+  auto kernel = BestInterleavedKernel();
+  RunChunks(batch, pool, [&](std::size_t begin, std::size_t end) {
+    AcceptsInterleaved(dfa, batch, begin, end, result, kernel);
+  });
+}
+
+void AcceptsBatch(const CompactNondeterministicAutomaton& nfa, const WordBatch& batch, std::uint64_t* result,
+                  utils::ThreadPool* pool) {
+  RunChunks(batch, pool, [&](std::size_t begin, std::size_t end) {
+    // the matcher owns the state set buffers, they are reused for all words of a chunk
+    Matcher matcher{nfa};
+    for (auto word = begin; word < end; word += 64) {
+      std::uint64_t bits = 0;
+      for (auto i = word, last = std::min(word + 64, end); i != last; ++i) {
+        matcher.Reset();
+        matcher.Feed(batch.symbols + batch.offsets[i], batch.symbols + batch.offsets[i + 1]);
+        bits |= std::uint64_t{matcher.IsAccepting()} << (i - word);
+      }
+      result[word / 64] = bits;
+    }
+  });
+}
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,107 @@
+#include <cppformlang/finite_automata/bit_parallel_automaton.h>
+#include <utils/bits.h>
+
+#include <cassert>
+#include <unordered_map>
+
+namespace cppformlang::finite_automata {
+
+template <std::size_t Words>
+BitParallelAutomaton<Words>::BitParallelAutomaton(const NondeterministicFiniteAutomaton& nfa)
+    : start_{}, final_{}, states_count_{nfa.StatesCount()} {
+  assert(states_count_ <= kMaxStates);
+  std::vector<State> states;
+  states.reserve(states_count_);
+  nfa.ForeachState([&](State state) { states.push_back(state); });
+  std::sort(states.begin(), states.end());
+  std::unordered_map<State, std::size_t> ids;
+  for (std::size_t id = 0; id != states.size(); ++id) {
+    ids.emplace(states[id], id);
+  }
+  auto set_bit = [](Mask& mask, std::size_t id) { mask[id / 64] |= std::uint64_t{1} << (id % 64); };
+  auto merge = [](Mask& to, const Mask& from) {
+    for (std::size_t i = 0; i != Words; ++i) {
+      to[i] |= from[i];
+    }
+  };
+
+  EpsilonClosureTable table{nfa};
+  std::vector<Mask> closures(states.size(), Mask{});
+  for (std::size_t id = 0; id != states.size(); ++id) {
+    table.ForeachInClosure(states[id], [&](State state) { set_bit(closures[id], ids[state]); });
+  }
+
+  nfa.ForeachSymbol([&](Symbol symbol) {
+    if (symbol != kEpsilon) {
+      symbols_.push_back(symbol);
+    }
+  });
+  std::sort(symbols_.begin(), symbols_.end());
+  successors_.assign(symbols_.size() * states_count_, Mask{});
+  nfa.ForeachTransition([&](State from, Symbol by, State to) {
+    if (by != kEpsilon) {
+      merge(successors_[Column(by) * states_count_ + ids[from]], closures[ids[to]]);
+    }
+  });
+  nfa.ForeachStartState([&](State state) { merge(start_, closures[ids[state]]); });
+  nfa.ForeachFinalState([&](State state) { set_bit(final_, ids[state]); });
+}
+
+template <std::size_t Words>
+bool BitParallelAutomaton<Words>::Step(Mask& active, Symbol symbol) const {
+  if (symbol == kEpsilon) {
+    return !IsEmpty(active);
+  }
+  auto column = Column(symbol);
+  Mask next{};
+  if (column != symbols_.size()) {
+    const auto* row = successors_.data() + column * states_count_;
+    for (std::size_t word = 0; word != Words; ++word) {
+      utils::foreach_bit(active[word], [&](unsigned bit) {
+        const auto& successors = row[word * 64 + bit];
+        for (std::size_t i = 0; i != Words; ++i) {
+          next[i] |= successors[i];
+        }
+      });
+    }
+  }
+  active = next;
+  return !IsEmpty(active);
+}
+
+template <std::size_t Words>
+bool BitParallelAutomaton<Words>::Accepts(const Symbol* begin, const Symbol* end) const {
+  auto active = start_;
+  for (; begin != end; ++begin) {
+    if (!Step(active, *begin)) {
+      return false;
+    }
+  }
+  return IsAccepting(active);
+}
+
+template <std::size_t Words>
+bool BitParallelAutomaton<Words>::IsAccepting(const Mask& active) const {
+  for (std::size_t i = 0; i != Words; ++i) {
+    if ((active[i] & final_[i]) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <std::size_t Words>
+bool BitParallelAutomaton<Words>::IsEmpty(const Mask& active) {
+  for (auto word : active) {
+    if (word != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template class BitParallelAutomaton<1>;
+template class BitParallelAutomaton<2>;
+template class BitParallelAutomaton<4>;
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,58 @@
+#include <cppformlang/finite_automata/compact_nondeterministic_automaton.h>
+#include <cppformlang/finite_automata/epsilon_closure_table.h>
+
+#include <cassert>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace cppformlang::finite_automata {
+
+CompactNondeterministicAutomaton::CompactNondeterministicAutomaton(
+    const FiniteAutomaton<NondeterministicTransitions>& nfa) {
+  EpsilonClosureTable closures{nfa};
+  nfa.ForeachState([&](State state) { states_.push_back(state); });
+  std::sort(states_.begin(), states_.end());
+  std::unordered_map<State, std::uint32_t> ids;
+  ids.reserve(states_.size());
+  for (std::size_t id = 0; id != states_.size(); ++id) {
+    ids.emplace(states_[id], static_cast<std::uint32_t>(id));
+  }
+  // every marked state must be a state of the automaton, a missing one would alias the state with id 0
+  auto id_of = [&](State state) {
+    auto it = ids.find(state);
+    assert(it != ids.end());
+    return it->second;
+  };
+  nfa.ForeachSymbol([&](Symbol symbol) {
+    if (symbol != kEpsilon) {
+      symbols_.push_back(symbol);
+    }
+  });
+  std::sort(symbols_.begin(), symbols_.end());
+
+  const auto columns = symbols_.size();
+  std::vector<std::vector<std::uint32_t>> targets(states_.size() * columns);
+  nfa.ForeachTransition([&](State from, Symbol by, State to) {
+    if (by != kEpsilon) {
+      auto& row = targets[id_of(from) * columns + Column(by)];
+      closures.ForeachInClosure(to, [&](State state) { row.push_back(id_of(state)); });
+    }
+  });
+  successors_begin_.reserve(targets.size() + 1);
+  successors_begin_.push_back(0);
+  for (auto& row : targets) {
+    std::sort(row.begin(), row.end());
+    successors_.insert(successors_.end(), row.begin(), std::unique(row.begin(), row.end()));
+    successors_begin_.push_back(successors_.size());
+  }
+
+  nfa.ForeachStartState([&](State state) {
+    closures.ForeachInClosure(state, [&](State to) { start_.push_back(id_of(to)); });
+  });
+  std::sort(start_.begin(), start_.end());
+  start_.erase(std::unique(start_.begin(), start_.end()), start_.end());
+  final_.assign(states_.size(), false);
+  nfa.ForeachFinalState([&](State state) { final_[id_of(state)] = true; });
+}
+
+}  // namespace cppformlang::finite_automata
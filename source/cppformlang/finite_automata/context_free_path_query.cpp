@@ -0,0 +1,198 @@
+#include <cppformlang/finite_automata/compact_nondeterministic_automaton.h>
+#include <cppformlang/finite_automata/context_free_path_query.h>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <map>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+using Entries = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+/// the boxes of a recursive automaton numbered as one automaton
+struct StateMachine {
+  explicit StateMachine(const RecursiveAutomaton& rsm) {
+    rsm.ForeachBox([&](Symbol label, const NondeterministicFiniteAutomaton& box) {
+      labels.push_back(label);
+      boxes.emplace_back(box);
+    });
+    // the boxes are ordered by label, so the numbering does not depend on the hash map
+    std::vector<std::size_t> order(boxes.size());
+    for (std::size_t i = 0; i != order.size(); ++i) {
+      order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) { return labels[lhs] < labels[rhs]; });
+    std::vector<Symbol> sorted_labels;
+    std::vector<CompactNondeterministicAutomaton> sorted_boxes;
+    for (auto i : order) {
+      sorted_labels.push_back(labels[i]);
+      sorted_boxes.push_back(std::move(boxes[i]));
+    }
+    labels = std::move(sorted_labels);
+    boxes = std::move(sorted_boxes);
+
+    for (std::uint32_t box = 0; box != boxes.size(); ++box) {
+      const auto& automaton = boxes[box];
+      const auto offset = static_cast<std::uint32_t>(box_of.size());
+      for (std::uint32_t state = 0; state != automaton.StatesCount(); ++state) {
+        box_of.push_back(box);
+        is_final.push_back(automaton.IsStateFinal(state));
+        is_start.push_back(false);
+        for (std::size_t column = 0; column != automaton.SymbolsCount(); ++column) {
+          auto& entries = symbols[automaton.GetSymbol(column)];
+          for (auto to = automaton.SuccessorsBegin(state, column), end = automaton.SuccessorsEnd(state, column);
+               to != end; ++to) {
+            entries.emplace_back(offset + state, offset + *to);
+          }
+        }
+      }
+      nullable.push_back(false);
+      for (auto state : automaton.StartStates()) {
+        is_start[offset + state] = true;
+        nullable.back() = nullable.back() || automaton.IsStateFinal(state);
+      }
+    }
+  }
+
+  /// the box of a label or kNone
+  std::uint32_t Box(Symbol label) const {
+    auto it = std::lower_bound(labels.begin(), labels.end(), label);
+    return it != labels.end() && *it == label ? static_cast<std::uint32_t>(it - labels.begin()) : kNone;
+  }
+
+  std::size_t StatesCount() const { return box_of.size(); }
+
+  static constexpr auto kNone = std::numeric_limits<std::uint32_t>::max();
+
+  std::vector<Symbol> labels;
+  std::vector<CompactNondeterministicAutomaton> boxes;
+  std::vector<bool> nullable;
+  std::vector<std::uint32_t> box_of;
+  std::vector<bool> is_start;
+  std::vector<bool> is_final;
+  // ordered, so the Kronecker sum is built the same way every time
+  std::map<Symbol, Entries> symbols;
+};
+
+/// a transitive closure that grows by semi-naive evaluation, kept with its transpose
+class IncrementalClosure {
+ public:
+  IncrementalClosure(std::size_t size, utils::ThreadPool* pool)
+      : closure_{size, size}, closure_transposed_{size, size}, pool_{pool} {}
+
+  /**
+   * \brief Adds edges and closes the relation again
+   *
+   * \details A pair is new only if it joins a new pair with any pair, so
+   * every round multiplies only the pairs added in the previous one, the
+   * closure on the left side is taken through the transposes.
+   *
+   * \return The pairs added to the closure
+   */
+  SparseBooleanMatrix Extend(const SparseBooleanMatrix& edges) {
+    auto delta = Subtract(edges, closure_, pool_);
+    SparseBooleanMatrix added{closure_.Rows(), closure_.Columns()};
+    while (delta.NonZeros() != 0) {
+      auto delta_transposed = delta.Transpose();
+      closure_ = Add(closure_, delta, pool_);
+      closure_transposed_ = Add(closure_transposed_, delta_transposed, pool_);
+      added = Add(added, delta, pool_);
+      auto right = Multiply(delta, closure_, pool_);
+      auto left = Multiply(delta_transposed, closure_transposed_, pool_).Transpose();
+      delta = Subtract(Add(right, left, pool_), closure_, pool_);
+    }
+    return added;
+  }
+
+ private:
+  SparseBooleanMatrix closure_;
+  SparseBooleanMatrix closure_transposed_;
+  utils::ThreadPool* pool_;
+};
+
+}  // namespace
+
+std::unordered_map<Symbol, SparseBooleanMatrix> ContextFreeReachability(const RecursiveAutomaton& rsm,
+                                                                         const LabeledGraph& graph,
+                                                                         utils::ThreadPool* pool) {
+  const StateMachine machine{rsm};
+  const auto vertices = graph.VerticesCount();
+  const auto states = machine.StatesCount();
+  assert(states * vertices <= std::numeric_limits<std::uint32_t>::max());
+
+  std::vector<Entries> label_entries(graph.LabelsCount());
+  for (State vertex = 0; vertex != vertices; ++vertex) {
+    graph.ForeachRun(vertex, [&](std::uint32_t column, const State* begin, const State* end) {
+      for (; begin != end; ++begin) {
+        label_entries[column].emplace_back(vertex, *begin);
+      }
+    });
+  }
+  std::vector<SparseBooleanMatrix> nonterminals;
+  for (std::size_t box = 0; box != machine.boxes.size(); ++box) {
+    nonterminals.push_back(machine.nullable[box] ? SparseBooleanMatrix::Identity(vertices)
+                                                 : SparseBooleanMatrix{vertices, vertices});
+  }
+
+  // the Kronecker sum of the symbol matrices and the graph matrices of the same symbols
+  SparseBooleanMatrix edges{states * vertices, states * vertices};
+  std::vector<SparseBooleanMatrix> box_symbols(machine.boxes.size());
+  for (auto& [symbol, entries] : machine.symbols) {
+    SparseBooleanMatrix symbol_matrix{states, states, entries};
+    if (auto box = machine.Box(symbol); box != StateMachine::kNone) {
+      edges = Add(edges, Kronecker(symbol_matrix, nonterminals[box], pool), pool);
+      box_symbols[box] = std::move(symbol_matrix);
+    } else if (auto column = graph.Column(symbol); column != graph.LabelsCount()) {
+      SparseBooleanMatrix label_matrix{vertices, vertices, std::move(label_entries[column])};
+      edges = Add(edges, Kronecker(symbol_matrix, label_matrix, pool), pool);
+    }
+  }
+
+  IncrementalClosure closure{states * vertices, pool};
+  while (edges.NonZeros() != 0) {
+    auto added = closure.Extend(edges);
+    // (start of N, u) -> (final of N, v) means u -N-> v
+    std::vector<Entries> found(machine.boxes.size());
+    added.ForeachEntry([&](std::uint32_t from, std::uint32_t to) {
+      auto from_state = from / vertices;
+      auto to_state = to / vertices;
+      if (machine.box_of[from_state] == machine.box_of[to_state] && machine.is_start[from_state] &&
+          machine.is_final[to_state]) {
+        found[machine.box_of[from_state]].emplace_back(from % vertices, to % vertices);
+      }
+    });
+    edges = SparseBooleanMatrix{states * vertices, states * vertices};
+    for (std::size_t box = 0; box != machine.boxes.size(); ++box) {
+      if (found[box].empty()) {
+        continue;
+      }
+      auto delta = Subtract(SparseBooleanMatrix{vertices, vertices, std::move(found[box])}, nonterminals[box], pool);
+      nonterminals[box] = Add(nonterminals[box], delta, pool);
+      // a label that no box reads adds no edge to the product
+      if (delta.NonZeros() != 0 && box_symbols[box].Rows() != 0) {
+        edges = Add(edges, Kronecker(box_symbols[box], delta, pool), pool);
+      }
+    }
+  }
+
+  std::unordered_map<Symbol, SparseBooleanMatrix> result;
+  for (std::size_t box = 0; box != machine.boxes.size(); ++box) {
+    result.emplace(machine.labels[box], std::move(nonterminals[box]));
+  }
+  return result;
+}
+
+std::vector<std::pair<State, State>> ContextFreePathQuery(const RecursiveAutomaton& rsm, const LabeledGraph& graph,
+                                                         utils::ThreadPool* pool) {
+  std::vector<std::pair<State, State>> result;
+  auto reachability = ContextFreeReachability(rsm, graph, pool);
+  if (auto it = reachability.find(rsm.GetInitLabel()); it != reachability.end()) {
+    it->second.ForeachEntry([&](std::uint32_t from, std::uint32_t to) { result.emplace_back(from, to); });
+  }
+  return result;
+}
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,221 @@
+#include <cppformlang/finite_automata/dense_deterministic_automaton.h>
+#include <cppformlang/finite_automata/minimization.h>
+#include <cppformlang/finite_automata/stats.h>
+#include <utils/hash.h>
+
+#include <bitset>
+#include <cassert>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+
+namespace cppformlang::finite_automata {
+
+DenseDeterministicAutomaton::DenseDeterministicAutomaton() : start_{kDeadState}, states_count_{0} {}
+
+DenseDeterministicAutomaton::DenseDeterministicAutomaton(const NondeterministicFiniteAutomaton& nfa)
+    : DenseDeterministicAutomaton() {
+  if (!nfa.IsDeterministic()) {
+    *this = DenseDeterministicAutomaton{nfa.ToDeterministic()};
+    return;
+  }
+  std::unordered_map<State, std::vector<std::pair<Symbol, State>>> adjacency;
+  nfa.ForeachTransition([&](State from, Symbol by, State to) {
+    if (by != kEpsilon) {
+      adjacency[from].emplace_back(by, to);
+    }
+  });
+  std::vector<Symbol> symbols;
+  nfa.ForeachSymbol([&](Symbol symbol) {
+    if (symbol != kEpsilon) {
+      symbols.push_back(symbol);
+    }
+  });
+  std::sort(symbols.begin(), symbols.end());
+  auto index_of = [&](Symbol symbol) {
+    return static_cast<std::size_t>(std::lower_bound(symbols.begin(), symbols.end(), symbol) - symbols.begin());
+  };
+
+  std::unordered_map<State, State> ids;
+  std::queue<State> to_process;
+  nfa.ForeachStartState([&](State state) {
+    ids.emplace(state, 0);
+    to_process.push(state);
+  });
+  if (to_process.empty()) {
+    alphabet_ = AlphabetPartition::Discrete(std::move(symbols));
+    return;
+  }
+  std::vector<State> order;
+  while (!to_process.empty()) {
+    auto current = to_process.front();
+    to_process.pop();
+    order.push_back(current);
+    auto& edges = adjacency[current];
+    std::sort(edges.begin(), edges.end());
+    for (auto& [_, to] : edges) {
+      if (ids.emplace(to, static_cast<State>(ids.size())).second) {
+        to_process.push(to);
+      }
+    }
+  }
+
+  // the edges of every symbol in the order of their sources, symbols with equal edges share a class
+  std::vector<std::vector<std::pair<State, State>>> edges_by_symbol(symbols.size());
+  for (State id = 0; id != order.size(); ++id) {
+    for (auto& [by, to] : adjacency[order[id]]) {
+      edges_by_symbol[index_of(by)].emplace_back(id, ids[to]);
+    }
+  }
+  auto hash = [&](std::uint32_t symbol) {
+    std::size_t seed = 0;
+    for (auto& [from, to] : edges_by_symbol[symbol]) {
+      utils::hash_combine(seed, from);
+      utils::hash_combine(seed, to);
+    }
+    return seed;
+  };
+  auto equal = [&](std::uint32_t left, std::uint32_t right) { return edges_by_symbol[left] == edges_by_symbol[right]; };
+  alphabet_ = AlphabetPartition{std::move(symbols), GroupEqual(edges_by_symbol.size(), hash, equal)};
+
+  start_ = 0;
+  states_count_ = order.size();
+  const auto columns = ColumnsCount();
+  next_.assign(states_count_ * columns, kDeadState);
+  final_.assign((states_count_ + 63) / 64, 0);
+  for (std::size_t id = 0; id != order.size(); ++id) {
+    if (nfa.IsStateFinal(order[id])) {
+      final_[id / 64] |= std::uint64_t{1} << (id % 64);
+    }
+  }
+  for (std::size_t index = 0; index != edges_by_symbol.size(); ++index) {
+    for (auto& [from, to] : edges_by_symbol[index]) {
+      next_[from * columns + alphabet_.ClassAt(index)] = to;
+    }
+  }
+}
+
+DenseDeterministicAutomaton::DenseDeterministicAutomaton(std::vector<Symbol> symbols, std::vector<State> next,
+                                                         const std::vector<State>& final_states, State start)
+    : DenseDeterministicAutomaton{AlphabetPartition::Discrete(std::move(symbols)), std::move(next), final_states,
+                                  start} {}
+
+DenseDeterministicAutomaton::DenseDeterministicAutomaton(AlphabetPartition alphabet, std::vector<State> next,
+                                                         const std::vector<State>& final_states, State start)
+    : alphabet_{std::move(alphabet)}, next_{std::move(next)}, start_{start} {
+  const auto columns = ColumnsCount();
+  states_count_ = columns == 0 ? (start == kDeadState ? 0 : start + 1) : next_.size() / columns;
+  for (auto state : final_states) {
+    states_count_ = std::max<std::size_t>(states_count_, state + 1);
+  }
+  final_.assign((states_count_ + 63) / 64, 0);
+  for (auto state : final_states) {
+    final_[state / 64] |= std::uint64_t{1} << (state % 64);
+  }
+  MergeColumns();
+}
+
+void DenseDeterministicAutomaton::MergeColumns() {
+  const auto columns = ColumnsCount();
+  const auto rows = next_.size() / std::max<std::size_t>(columns, 1);
+  auto hash = [&](std::uint32_t column) {
+    std::size_t seed = 0;
+    for (std::size_t row = 0; row != rows; ++row) {
+      utils::hash_combine(seed, next_[row * columns + column]);
+    }
+    return seed;
+  };
+  auto equal = [&](std::uint32_t left, std::uint32_t right) {
+    for (std::size_t row = 0; row != rows; ++row) {
+      if (next_[row * columns + left] != next_[row * columns + right]) {
+        return false;
+      }
+    }
+    return true;
+  };
+  auto groups = GroupEqual(columns, hash, equal);
+  const auto merged = groups.empty() ? 0 : std::size_t{*std::max_element(groups.begin(), groups.end())} + 1;
+  if (merged == columns) {
+    return;
+  }
+  std::vector<Symbol> symbols(alphabet_.SymbolsCount());
+  std::vector<std::uint32_t> classes(symbols.size());
+  for (std::size_t index = 0; index != symbols.size(); ++index) {
+    symbols[index] = alphabet_.GetSymbol(index);
+    classes[index] = groups[alphabet_.ClassAt(index)];
+  }
+  AlphabetPartition alphabet{std::move(symbols), classes};
+  std::vector<State> next(rows * merged);
+  for (std::uint32_t column = 0; column != columns; ++column) {
+    auto to_column = alphabet.Class(alphabet_.Representative(column));
+    for (std::size_t row = 0; row != rows; ++row) {
+      next[row * merged + to_column] = next_[row * columns + column];
+    }
+  }
+  alphabet_ = std::move(alphabet);
+  next_ = std::move(next);
+}
+
+bool DenseDeterministicAutomaton::Accepts(const Symbol* begin, const Symbol* end) const {
+  stats::ScopedPhase phase{Phase::kAccepts};
+  auto state = start_;
+  const auto columns = ColumnsCount();
+  for (; begin != end && state != kDeadState; ++begin) {
+    if (*begin == kEpsilon) {
+      continue;
+    }
+    auto column = Column(*begin);
+    if (column == columns) {
+      return false;
+    }
+    state = next_[state * columns + column];
+  }
+  return state != kDeadState && IsStateFinal(state);
+}
+
+std::size_t DenseDeterministicAutomaton::FinalStatesCount() const {
+  std::size_t count = 0;
+  for (auto word : final_) {
+    count += std::bitset<64>{word}.count();
+  }
+  return count;
+}
+
+std::size_t DenseDeterministicAutomaton::MemoryUsage() const {
+  return alphabet_.MemoryUsage() + next_.capacity() * sizeof(State) + final_.capacity() * sizeof(std::uint64_t);
+}
+
+DenseDeterministicAutomaton DenseDeterministicAutomaton::Minimize() const {
+  stats::ScopedPhase phase{Phase::kMinimize};
+  std::vector<State> identity(states_count_ + 1);
+  std::iota(identity.begin(), identity.end(), 0);
+  auto trimmed = Quotient(*this, identity);
+  return Quotient(trimmed, HopcroftPartition(trimmed, FinalLabels(trimmed)));
+}
+
+NondeterministicFiniteAutomaton DenseDeterministicAutomaton::ToNondeterministic() const {
+  NondeterministicFiniteAutomaton nfa;
+  const auto columns = ColumnsCount();
+  for (State from = 0; from != states_count_; ++from) {
+    for (std::uint32_t column = 0; column != columns; ++column) {
+      if (auto to = next_[from * columns + column]; to != kDeadState) {
+        alphabet_.ForeachSymbolOf(column, [&](Symbol symbol) { nfa.AddTransition(from + 1, symbol, to + 1); });
+      }
+    }
+  }
+  // a start or final state may have no transitions
+  if (start_ != kDeadState) {
+    nfa.AddState(start_ + 1);
+    nfa.SetStartState(start_ + 1, true);
+  }
+  for (State state = 0; state != states_count_; ++state) {
+    if (IsStateFinal(state)) {
+      nfa.AddState(state + 1);
+      nfa.SetFinalState(state + 1, true);
+    }
+  }
+  return nfa;
+}
+
+}  // namespace cppformlang::finite_automata
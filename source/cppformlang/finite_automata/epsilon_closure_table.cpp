@@ -0,0 +1,138 @@
+#include <cppformlang/finite_automata/epsilon_closure_table.h>
+#include <cppformlang/finite_automata/stats.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace cppformlang::finite_automata {
+
+EpsilonClosureTable::EpsilonClosureTable(const FiniteAutomaton<NondeterministicTransitions>& nfa) : offsets_{0} {
+  // dense numbering of the states touched by epsilon transitions
+  std::unordered_map<State, std::uint32_t> ids;
+  std::vector<State> states;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+  auto id_of = [&](State state) {
+    auto [it, inserted] = ids.emplace(state, static_cast<std::uint32_t>(states.size()));
+    if (inserted) {
+      states.push_back(state);
+    }
+    return it->second;
+  };
+  nfa.ForeachTransition([&](State from, Symbol by, State to) {
+    if (by == kEpsilon && from != to) {
+      edges.emplace_back(id_of(from), id_of(to));
+    }
+  });
+  if (edges.empty()) {
+    return;
+  }
+  const auto count = static_cast<std::uint32_t>(states.size());
+  std::sort(edges.begin(), edges.end());
+  std::vector<std::uint32_t> edge_offsets(count + 1, 0);
+  for (auto& [from, _] : edges) {
+    ++edge_offsets[from + 1];
+  }
+  for (std::uint32_t i = 0; i != count; ++i) {
+    edge_offsets[i + 1] += edge_offsets[i];
+  }
+
+  // iterative Tarjan, components are found in reverse topological order
+  constexpr auto kUnvisited = std::numeric_limits<std::uint32_t>::max();
+  std::vector<std::uint32_t> index(count, kUnvisited);
+  std::vector<std::uint32_t> lowlink(count, 0);
+  std::vector<std::uint32_t> component(count, kUnvisited);
+  std::vector<std::uint32_t> tarjan_stack;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> call_stack;
+  std::vector<std::uint32_t> members;
+  std::vector<std::uint32_t> member_offsets{0};
+  std::uint32_t counter = 0;
+  for (std::uint32_t root = 0; root != count; ++root) {
+    if (index[root] != kUnvisited) {
+      continue;
+    }
+    index[root] = lowlink[root] = counter++;
+    tarjan_stack.push_back(root);
+    call_stack.emplace_back(root, edge_offsets[root]);
+    while (!call_stack.empty()) {
+      auto& [node, edge] = call_stack.back();
+      if (edge != edge_offsets[node + 1]) {
+        auto to = edges[edge++].second;
+        if (index[to] == kUnvisited) {
+          index[to] = lowlink[to] = counter++;
+          tarjan_stack.push_back(to);
+          call_stack.emplace_back(to, edge_offsets[to]);
+        } else if (component[to] == kUnvisited) {
+          lowlink[node] = std::min(lowlink[node], index[to]);
+        }
+        continue;
+      }
+      auto finished = node;
+      call_stack.pop_back();
+      if (!call_stack.empty()) {
+        auto parent = call_stack.back().first;
+        lowlink[parent] = std::min(lowlink[parent], lowlink[finished]);
+      }
+      if (lowlink[finished] != index[finished]) {
+        continue;
+      }
+      auto id = static_cast<std::uint32_t>(member_offsets.size() - 1);
+      std::uint32_t member;
+      do {
+        member = tarjan_stack.back();
+        tarjan_stack.pop_back();
+        component[member] = id;
+        members.push_back(member);
+      } while (member != finished);
+      member_offsets.push_back(static_cast<std::uint32_t>(members.size()));
+    }
+  }
+
+  // the closure of a component is its members and the closures of its successors
+  const auto components_count = member_offsets.size() - 1;
+  std::vector<std::size_t> stamp(count, components_count);
+  std::vector<std::uint32_t> closure_nodes;
+  for (std::size_t id = 0; id != components_count; ++id) {
+    auto add = [&](std::uint32_t node) {
+      if (stamp[node] != id) {
+        stamp[node] = id;
+        closure_nodes.push_back(node);
+      }
+    };
+    for (auto i = member_offsets[id]; i != member_offsets[id + 1]; ++i) {
+      add(members[i]);
+    }
+    for (auto i = member_offsets[id]; i != member_offsets[id + 1]; ++i) {
+      auto from = members[i];
+      for (auto edge = edge_offsets[from]; edge != edge_offsets[from + 1]; ++edge) {
+        auto successor = component[edges[edge].second];
+        if (successor == id) {
+          continue;
+        }
+        for (auto j = offsets_[successor]; j != offsets_[successor + 1]; ++j) {
+          add(closure_nodes[j]);
+        }
+      }
+    }
+    stats::RecordClosure(closure_nodes.size() - offsets_.back());
+    offsets_.push_back(closure_nodes.size());
+  }
+  closures_.reserve(closure_nodes.size());
+  for (auto node : closure_nodes) {
+    closures_.push_back(states[node]);
+  }
+  components_.reserve(count);
+  for (std::uint32_t node = 0; node != count; ++node) {
+    components_.emplace(states[node], component[node]);
+  }
+}
+
+std::size_t EpsilonClosureTable::ClosureSize(State state) const {
+  auto it = components_.find(state);
+  if (it == components_.end()) {
+    return 1;
+  }
+  return offsets_[it->second + 1] - offsets_[it->second];
+}
+
+}  // namespace cppformlang::finite_automata
@@ -1,8 +1,44 @@
 #include <cppformlang/finite_automata/finite_automation.h>
 #include <cppformlang/finite_automata/nondeterministic_transitions.h>
+#include <utils/memory_usage.h>
+
+#include <algorithm>
+#include <utility>
 
 namespace cppformlang::finite_automata {
 
+template <typename Transitions>
+FiniteAutomaton<Transitions>::FiniteAutomaton() = default;
+
+template <typename Transitions>
+FiniteAutomaton<Transitions>::FiniteAutomaton(const FiniteAutomaton& other) = default;
+
+template <typename Transitions>
+FiniteAutomaton<Transitions>::FiniteAutomaton(FiniteAutomaton&& other) noexcept = default;
+
+template <typename Transitions>
+FiniteAutomaton<Transitions>& FiniteAutomaton<Transitions>::operator=(const FiniteAutomaton& other) {
+  Transitions::operator=(other);
+  states_ = other.states_;
+  start_states_ = other.start_states_;
+  final_states_ = other.final_states_;
+  symbols_ = other.symbols_;
+  // differs from the counts of both automata before the assignment
+  modifications_ = std::max(modifications_, other.modifications_) + 1;
+  return *this;
+}
+
+template <typename Transitions>
+FiniteAutomaton<Transitions>& FiniteAutomaton<Transitions>::operator=(FiniteAutomaton&& other) {
+  Transitions::operator=(std::move(other));
+  states_ = std::move(other.states_);
+  start_states_ = std::move(other.start_states_);
+  final_states_ = std::move(other.final_states_);
+  symbols_ = std::move(other.symbols_);
+  modifications_ = std::max(modifications_, other.modifications_) + 1;
+  return *this;
+}
+
 template <typename Transitions>
 bool FiniteAutomaton<Transitions>::AddTransition(State from, Symbol by, State to) {
   if (!Transitions::AddTransition(from, by, to)) {
@@ -11,6 +47,7 @@ bool FiniteAutomaton<Transitions>::AddTransition(State from, Symbol by, State to
   ++states_[from];
   ++states_[to];
   ++symbols_[by];
+  ++modifications_;
   return true;
 }
 template <typename Transitions>
@@ -31,6 +68,17 @@ bool FiniteAutomaton<Transitions>::RemoveTransition(State from, Symbol by, State
   if (auto it_by = symbols_.find(by); --it_by->second == 0) {
     symbols_.erase(it_by);
   }
+  ++modifications_;
+  return true;
+}
+
+template <typename Transitions>
+bool FiniteAutomaton<Transitions>::AddState(State state) {
+  // the extra reference of a new state is never released by RemoveTransition
+  if (!states_.try_emplace(state, 1).second) {
+    return false;
+  }
+  ++modifications_;
   return true;
 }
 
@@ -65,6 +113,7 @@ bool FiniteAutomaton<Transitions>::SetStartState(State state, bool is_start) {
   } else {
     start_states_.erase(state);
   }
+  ++modifications_;
   return true;
 }
 
@@ -79,6 +128,7 @@ bool FiniteAutomaton<Transitions>::SetFinalState(State state, bool is_final) {
   } else {
     final_states_.erase(state);
   }
+  ++modifications_;
   return true;
 }
 
@@ -97,6 +147,13 @@ bool FiniteAutomaton<Transitions>::IsAcyclic() const {
   return false;
 }
 
+template <typename Transitions>
+std::size_t FiniteAutomaton<Transitions>::MemoryUsage() const {
+  return Transitions::MemoryUsage() + utils::hash_container_memory(states_) +
+         utils::hash_container_memory(start_states_) + utils::hash_container_memory(final_states_) +
+         utils::hash_container_memory(symbols_);
+}
+
 template class FiniteAutomaton<NondeterministicTransitions>;
 
 }  // namespace cppformlang::finite_automata
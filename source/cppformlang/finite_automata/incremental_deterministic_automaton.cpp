@@ -0,0 +1,347 @@
+#include <cppformlang/finite_automata/incremental_deterministic_automaton.h>
+#include <utils/hash.h>
+
+#include <algorithm>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+/// the subsets kept unreachable before a compaction, besides as many as the reachable ones
+constexpr std::size_t kCompactionSlack = 64;
+
+bool BySymbol(const std::pair<Symbol, State>& edge, Symbol symbol) { return edge.first < symbol; }
+
+}  // namespace
+
+std::size_t IncrementalDeterministicAutomaton::HashSubset::operator()(const std::vector<State>& value) const {
+  return utils::hash_range<State>(value.begin(), value.end());
+}
+
+IncrementalDeterministicAutomaton::IncrementalDeterministicAutomaton()
+    : epsilons_count_{0}, start_{kDead}, compacted_size_{0}, last_update_size_{0}, minimal_valid_{false} {}
+
+IncrementalDeterministicAutomaton::IncrementalDeterministicAutomaton(const NondeterministicFiniteAutomaton& nfa)
+    : IncrementalDeterministicAutomaton() {
+  nfa_ = nfa;
+  nfa_.ForeachTransition([&](State from, Symbol by, State to) {
+    edges_[from].emplace_back(by, to);
+    epsilons_count_ += by == kEpsilon;
+  });
+  for (auto& [_, edges] : edges_) {
+    std::sort(edges.begin(), edges.end());
+  }
+  Rebuild();
+}
+
+bool IncrementalDeterministicAutomaton::AddTransition(State from, Symbol by, State to) {
+  if (!nfa_.AddTransition(from, by, to)) {
+    return false;
+  }
+  auto& edges = edges_[from];
+  edges.insert(std::lower_bound(edges.begin(), edges.end(), std::make_pair(by, to)), {by, to});
+  Changed();
+  if (by == kEpsilon) {
+    ++epsilons_count_;
+    Rebuild();
+  } else {
+    UpdateRows(from, by);
+  }
+  MaybeCompact();
+  return true;
+}
+
+bool IncrementalDeterministicAutomaton::RemoveTransition(State from, Symbol by, State to) {
+  const bool from_start = nfa_.IsStateStart(from);
+  const bool to_start = nfa_.IsStateStart(to);
+  const bool from_final = nfa_.IsStateFinal(from);
+  const bool to_final = nfa_.IsStateFinal(to);
+  if (!nfa_.RemoveTransition(from, by, to)) {
+    return false;
+  }
+  auto& edges = edges_[from];
+  edges.erase(std::lower_bound(edges.begin(), edges.end(), std::make_pair(by, to)));
+  if (edges.empty()) {
+    edges_.erase(from);
+  }
+  Changed();
+  if (by == kEpsilon) {
+    --epsilons_count_;
+    Rebuild();
+    return true;
+  }
+  UpdateRows(from, by);
+  // a state left without transitions loses its marks
+  if (from_final && !nfa_.IsStateFinal(from)) {
+    UpdateFinal(from);
+  }
+  if (to_final && !nfa_.IsStateFinal(to)) {
+    UpdateFinal(to);
+  }
+  if ((from_start && !nfa_.IsStateStart(from)) || (to_start && !nfa_.IsStateStart(to))) {
+    UpdateStart();
+  }
+  MaybeCompact();
+  return true;
+}
+
+bool IncrementalDeterministicAutomaton::SetStartState(State state, bool is_start) {
+  if (nfa_.IsStateStart(state) == is_start) {
+    return nfa_.SetStartState(state, is_start);
+  }
+  if (!nfa_.SetStartState(state, is_start)) {
+    return false;
+  }
+  Changed();
+  UpdateStart();
+  MaybeCompact();
+  return true;
+}
+
+bool IncrementalDeterministicAutomaton::SetFinalState(State state, bool is_final) {
+  if (nfa_.IsStateFinal(state) == is_final) {
+    return nfa_.SetFinalState(state, is_final);
+  }
+  if (!nfa_.SetFinalState(state, is_final)) {
+    return false;
+  }
+  Changed();
+  UpdateFinal(state);
+  return true;
+}
+
+bool IncrementalDeterministicAutomaton::Accepts(const Symbol* begin, const Symbol* end) const {
+  auto state = start_;
+  for (; begin != end && state != kDead; ++begin) {
+    if (*begin == kEpsilon) {
+      continue;
+    }
+    auto& row = rows_[state];
+    auto it = std::lower_bound(row.begin(), row.end(), *begin, BySymbol);
+    state = it == row.end() || it->first != *begin ? kDead : it->second;
+  }
+  return state != kDead && final_[state];
+}
+
+const DenseDeterministicAutomaton& IncrementalDeterministicAutomaton::Minimal() {
+  if (minimal_valid_) {
+    return minimal_;
+  }
+  Compact();
+  std::vector<Symbol> symbols;
+  for (auto& row : rows_) {
+    for (auto& [symbol, _] : row) {
+      symbols.push_back(symbol);
+    }
+  }
+  std::sort(symbols.begin(), symbols.end());
+  symbols.erase(std::unique(symbols.begin(), symbols.end()), symbols.end());
+  std::vector<State> next(subsets_.size() * symbols.size(), kDead);
+  std::vector<State> final_states;
+  for (State state = 0; state != subsets_.size(); ++state) {
+    for (auto& [symbol, to] : rows_[state]) {
+      auto column = std::lower_bound(symbols.begin(), symbols.end(), symbol) - symbols.begin();
+      next[state * symbols.size() + static_cast<std::size_t>(column)] = to;
+    }
+    if (final_[state]) {
+      final_states.push_back(state);
+    }
+  }
+  minimal_ = DenseDeterministicAutomaton{std::move(symbols), std::move(next), final_states, start_}.Minimize();
+  minimal_valid_ = true;
+  return minimal_;
+}
+
+std::vector<State> IncrementalDeterministicAutomaton::Closure(std::vector<State> states) const {
+  std::sort(states.begin(), states.end());
+  states.erase(std::unique(states.begin(), states.end()), states.end());
+  if (epsilons_count_ == 0) {
+    return states;
+  }
+  for (std::size_t i = 0; i != states.size(); ++i) {
+    auto it = edges_.find(states[i]);
+    if (it == edges_.end()) {
+      continue;
+    }
+    for (auto edge = it->second.begin(); edge != it->second.end() && edge->first == kEpsilon; ++edge) {
+      if (std::find(states.begin(), states.end(), edge->second) == states.end()) {
+        states.push_back(edge->second);
+      }
+    }
+  }
+  std::sort(states.begin(), states.end());
+  return states;
+}
+
+std::vector<State> IncrementalDeterministicAutomaton::Move(State subset, Symbol symbol) const {
+  std::vector<State> states;
+  for (auto state : subsets_[subset]) {
+    auto it = edges_.find(state);
+    if (it == edges_.end()) {
+      continue;
+    }
+    for (auto edge = std::lower_bound(it->second.begin(), it->second.end(), symbol, BySymbol);
+         edge != it->second.end() && edge->first == symbol; ++edge) {
+      states.push_back(edge->second);
+    }
+  }
+  return Closure(std::move(states));
+}
+
+State IncrementalDeterministicAutomaton::Intern(std::vector<State> subset) {
+  if (subset.empty()) {
+    return kDead;
+  }
+  auto [it, inserted] = ids_.emplace(std::move(subset), static_cast<State>(subsets_.size()));
+  if (!inserted) {
+    return it->second;
+  }
+  const auto id = it->second;
+  bool is_final = false;
+  for (auto state : it->first) {
+    users_[state].push_back(id);
+    is_final = is_final || nfa_.IsStateFinal(state);
+  }
+  subsets_.push_back(it->first);
+  rows_.emplace_back();
+  final_.push_back(is_final);
+  to_build_.push_back(id);
+  return id;
+}
+
+void IncrementalDeterministicAutomaton::BuildRows() {
+  std::vector<Symbol> symbols;
+  while (!to_build_.empty()) {
+    const auto id = to_build_.back();
+    to_build_.pop_back();
+    ++last_update_size_;
+    symbols.clear();
+    for (auto state : subsets_[id]) {
+      if (auto it = edges_.find(state); it != edges_.end()) {
+        for (auto& [symbol, _] : it->second) {
+          if (symbol != kEpsilon) {
+            symbols.push_back(symbol);
+          }
+        }
+      }
+    }
+    std::sort(symbols.begin(), symbols.end());
+    symbols.erase(std::unique(symbols.begin(), symbols.end()), symbols.end());
+    for (auto symbol : symbols) {
+      if (auto to = Intern(Move(id, symbol)); to != kDead) {
+        rows_[id].emplace_back(symbol, to);
+      }
+    }
+  }
+}
+
+void IncrementalDeterministicAutomaton::SetRow(State subset, Symbol symbol, State to) {
+  auto& row = rows_[subset];
+  auto it = std::lower_bound(row.begin(), row.end(), symbol, BySymbol);
+  if (it != row.end() && it->first == symbol) {
+    if (to == kDead) {
+      row.erase(it);
+    } else {
+      it->second = to;
+    }
+  } else if (to != kDead) {
+    row.insert(it, {symbol, to});
+  }
+}
+
+void IncrementalDeterministicAutomaton::UpdateRows(State state, Symbol symbol) {
+  auto it = users_.find(state);
+  if (it == users_.end()) {
+    return;
+  }
+  // the subsets built meanwhile get their rows from the edited automaton
+  const auto users = it->second;
+  for (auto id : users) {
+    ++last_update_size_;
+    SetRow(id, symbol, Intern(Move(id, symbol)));
+  }
+  BuildRows();
+}
+
+void IncrementalDeterministicAutomaton::UpdateFinal(State state) {
+  auto it = users_.find(state);
+  if (it == users_.end()) {
+    return;
+  }
+  for (auto id : it->second) {
+    auto& subset = subsets_[id];
+    final_[id] = std::any_of(subset.begin(), subset.end(), [&](State member) { return nfa_.IsStateFinal(member); });
+  }
+}
+
+void IncrementalDeterministicAutomaton::UpdateStart() {
+  std::vector<State> starts;
+  nfa_.ForeachStartState([&](State state) { starts.push_back(state); });
+  start_ = Intern(Closure(std::move(starts)));
+  BuildRows();
+}
+
+void IncrementalDeterministicAutomaton::Rebuild() {
+  subsets_.clear();
+  rows_.clear();
+  final_.clear();
+  ids_.clear();
+  users_.clear();
+  UpdateStart();
+  compacted_size_ = subsets_.size();
+}
+
+void IncrementalDeterministicAutomaton::MaybeCompact() {
+  if (subsets_.size() > 2 * compacted_size_ + kCompactionSlack) {
+    Compact();
+  }
+}
+
+void IncrementalDeterministicAutomaton::Compact() {
+  // the reachable subsets in breadth-first order
+  std::vector<State> ids(subsets_.size(), kDead);
+  std::vector<State> order;
+  if (start_ != kDead) {
+    ids[start_] = 0;
+    order.push_back(start_);
+  }
+  for (std::size_t i = 0; i != order.size(); ++i) {
+    for (auto& [_, to] : rows_[order[i]]) {
+      if (ids[to] == kDead) {
+        ids[to] = static_cast<State>(order.size());
+        order.push_back(to);
+      }
+    }
+  }
+
+  std::vector<std::vector<State>> subsets;
+  std::vector<std::vector<std::pair<Symbol, State>>> rows;
+  std::vector<bool> final;
+  ids_.clear();
+  users_.clear();
+  for (auto old_id : order) {
+    const auto id = static_cast<State>(subsets.size());
+    for (auto& [_, to] : rows_[old_id]) {
+      to = ids[to];
+    }
+    for (auto state : subsets_[old_id]) {
+      users_[state].push_back(id);
+    }
+    ids_.emplace(subsets_[old_id], id);
+    subsets.push_back(std::move(subsets_[old_id]));
+    rows.push_back(std::move(rows_[old_id]));
+    final.push_back(final_[old_id]);
+  }
+  subsets_ = std::move(subsets);
+  rows_ = std::move(rows);
+  final_ = std::move(final);
+  start_ = start_ == kDead ? kDead : 0;
+  compacted_size_ = subsets_.size();
+}
+
+void IncrementalDeterministicAutomaton::Changed() {
+  last_update_size_ = 0;
+  minimal_valid_ = false;
+}
+
+}  // namespace cppformlang::finite_automata
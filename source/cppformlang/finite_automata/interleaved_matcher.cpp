@@ -0,0 +1,145 @@
+#include <cppformlang/finite_automata/interleaved_matcher.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CPPFORMLANG_HAS_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+constexpr std::size_t kLanes = 8;
+constexpr auto kDead = DenseDeterministicAutomaton::kDeadState;
+
+/**
+ * \brief Hands out the words of a batch to the lanes
+ *
+ * \details Prepare finishes the lanes whose word has ended or died, loads
+ * the next words into them and gives the column of the next symbol of every
+ * active lane, so the kernels only do the table loads.
+ */
+class LaneScheduler {
+ public:
+  LaneScheduler(const DenseDeterministicAutomaton& dfa, const WordBatch& batch, std::size_t begin, std::size_t end,
+                std::uint64_t* result)
+      : dfa_{dfa}, batch_{batch}, next_word_{begin}, end_word_{end}, result_{result} {
+    std::fill(result + begin / 64, result + (end + 63) / 64, 0);
+  }
+
+  /// returns the mask of the active lanes, zero when all words are checked
+  unsigned Prepare(State* states, std::uint32_t* columns) {
+    const auto columns_count = dfa_.ColumnsCount();
+    unsigned mask = 0;
+    for (std::size_t lane = 0; lane != kLanes; ++lane) {
+      while (true) {
+        auto& current = lanes_[lane];
+        if (current.it == nullptr) {
+          if (next_word_ == end_word_) {
+            break;
+          }
+          current.it = batch_.symbols + batch_.offsets[next_word_];
+          current.end = batch_.symbols + batch_.offsets[next_word_ + 1];
+          current.word = next_word_++;
+          states[lane] = dfa_.StartState();
+        }
+        while (current.it != current.end && *current.it == kEpsilon) {
+          ++current.it;
+        }
+        if (states[lane] != kDead && current.it != current.end) {
+          auto symbol = *current.it++;
+          auto column = dfa_.Column(symbol);
+          if (column != columns_count) {
+            columns[lane] = static_cast<std::uint32_t>(column);
+            mask |= 1U << lane;
+            break;
+          }
+          states[lane] = kDead;
+        }
+        if (states[lane] != kDead && dfa_.IsStateFinal(states[lane])) {
+          result_[current.word / 64] |= std::uint64_t{1} << (current.word % 64);
+        }
+        current.it = nullptr;
+      }
+    }
+    return mask;
+  }
+
+ private:
+  struct Lane {
+    const Symbol* it = nullptr;
+    const Symbol* end = nullptr;
+    std::size_t word = 0;
+  };
+
+  const DenseDeterministicAutomaton& dfa_;
+  const WordBatch& batch_;
+  std::size_t next_word_;
+  std::size_t end_word_;
+  std::uint64_t* result_;
+  std::array<Lane, kLanes> lanes_;
+};
+
+void ScalarKernel(const DenseDeterministicAutomaton& dfa, LaneScheduler& scheduler) {
+  const auto* table = dfa.Transitions();
+  const auto columns_count = dfa.ColumnsCount();
+  State states[kLanes] = {};
+  std::uint32_t columns[kLanes] = {};
+  while (auto mask = scheduler.Prepare(states, columns)) {
+    for (std::size_t lane = 0; lane != kLanes; ++lane) {
+      if ((mask >> lane) & 1U) {
+        states[lane] = table[states[lane] * columns_count + columns[lane]];
+      }
+    }
+  }
+}
+
+#ifdef CPPFORMLANG_HAS_AVX2_KERNEL
+__attribute__((target("avx2"))) void Avx2Kernel(const DenseDeterministicAutomaton& dfa, LaneScheduler& scheduler) {
+  const auto* table = reinterpret_cast<const int*>(dfa.Transitions());
+  const auto stride = _mm256_set1_epi32(static_cast<int>(dfa.ColumnsCount()));
+  const auto lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+  alignas(32) State states[kLanes] = {};
+  alignas(32) std::uint32_t columns[kLanes] = {};
+  while (auto mask = scheduler.Prepare(states, columns)) {
+    auto current = _mm256_load_si256(reinterpret_cast<const __m256i*>(states));
+    auto column = _mm256_load_si256(reinterpret_cast<const __m256i*>(columns));
+    auto index = _mm256_add_epi32(_mm256_mullo_epi32(current, stride), column);
+    auto active = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(static_cast<int>(mask)), lane_bits), lane_bits);
+    auto next = _mm256_mask_i32gather_epi32(current, table, index, active, 4);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(states), next);
+  }
+}
+#endif
+
+}  // namespace
+
+InterleavedKernel BestInterleavedKernel() {
+#ifdef CPPFORMLANG_HAS_AVX2_KERNEL
+  if (__builtin_cpu_supports("avx2")) {
+    return InterleavedKernel::kAvx2;
+  }
+#endif
+  return InterleavedKernel::kScalar;
+}
+
+void AcceptsInterleaved(const DenseDeterministicAutomaton& dfa, const WordBatch& batch, std::size_t begin,
+                        std::size_t end, std::uint64_t* result, InterleavedKernel kernel) {
+  LaneScheduler scheduler{dfa, batch, begin, end, result};
+#ifdef CPPFORMLANG_HAS_AVX2_KERNEL
+  auto fits = dfa.StatesCount() * dfa.ColumnsCount() <= static_cast<std::size_t>(std::numeric_limits<int>::max());
+  if (kernel == InterleavedKernel::kAvx2 && fits && __builtin_cpu_supports("avx2")) {
+    Avx2Kernel(dfa, scheduler);
+    return;
+  }
+#else
+  (void)kernel;
+#endif
+  ScalarKernel(dfa, scheduler);
+}
+
+}  // namespace cppformlang::finite_automata
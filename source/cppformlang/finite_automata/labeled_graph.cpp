@@ -0,0 +1,51 @@
+#include <cppformlang/finite_automata/labeled_graph.h>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <tuple>
+
+namespace cppformlang::finite_automata {
+
+LabeledGraph::LabeledGraph() : runs_begin_{0}, runs_{Run{0, 0}} {}
+
+LabeledGraph::LabeledGraph(std::size_t vertices_count, std::vector<LabeledEdge> edges) {
+  for (auto& edge : edges) {
+    assert(edge.from < vertices_count && edge.to < vertices_count);
+    labels_.push_back(edge.label);
+  }
+  std::sort(labels_.begin(), labels_.end());
+  labels_.erase(std::unique(labels_.begin(), labels_.end()), labels_.end());
+
+  auto key = [](const LabeledEdge& edge) { return std::tie(edge.from, edge.label, edge.to); };
+  std::sort(edges.begin(), edges.end(),
+            [&](const LabeledEdge& lhs, const LabeledEdge& rhs) { return key(lhs) < key(rhs); });
+  edges.erase(std::unique(edges.begin(), edges.end(),
+                          [&](const LabeledEdge& lhs, const LabeledEdge& rhs) { return key(lhs) == key(rhs); }),
+              edges.end());
+
+  runs_begin_.reserve(vertices_count + 1);
+  targets_.reserve(edges.size());
+  auto edge = edges.begin();
+  for (State vertex = 0; vertex != vertices_count; ++vertex) {
+    runs_begin_.push_back(runs_.size());
+    for (auto first = edge; edge != edges.end() && edge->from == vertex; ++edge) {
+      if (edge == first || std::prev(edge)->label != edge->label) {
+        runs_.push_back(Run{static_cast<std::uint32_t>(Column(edge->label)), targets_.size()});
+      }
+      targets_.push_back(edge->to);
+    }
+  }
+  runs_begin_.push_back(runs_.size());
+  runs_.push_back(Run{0, targets_.size()});
+}
+
+std::size_t LabeledGraph::Column(Symbol label) const {
+  auto it = std::lower_bound(labels_.begin(), labels_.end(), label);
+  if (it == labels_.end() || *it != label) {
+    return labels_.size();
+  }
+  return static_cast<std::size_t>(it - labels_.begin());
+}
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,294 @@
+#include <cppformlang/finite_automata/compact_nondeterministic_automaton.h>
+#include <cppformlang/finite_automata/nondeterministic_finite_automaton.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <vector>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+constexpr auto kNone = std::numeric_limits<std::uint32_t>::max();
+
+/// how a node of a search was reached, the start nodes have no parent
+struct Step {
+  std::uint32_t parent;
+  Symbol symbol;
+};
+
+/// the word read along the steps from a start node to a node
+void Trace(const std::vector<Step>& steps, std::uint32_t node, std::vector<Symbol>* word) {
+  if (word == nullptr) {
+    return;
+  }
+  word->clear();
+  for (; steps[node].parent != kNone; node = steps[node].parent) {
+    word->push_back(steps[node].symbol);
+  }
+  std::reverse(word->begin(), word->end());
+}
+
+/// the column of right for every column of left, kNone if right does not read the symbol
+std::vector<std::uint32_t> MatchColumns(const CompactNondeterministicAutomaton& left,
+                                        const CompactNondeterministicAutomaton& right) {
+  std::vector<std::uint32_t> columns(left.SymbolsCount(), kNone);
+  for (std::size_t column = 0; column != left.SymbolsCount(); ++column) {
+    auto right_column = right.Column(left.GetSymbol(column));
+    if (right_column != right.SymbolsCount()) {
+      columns[column] = static_cast<std::uint32_t>(right_column);
+    }
+  }
+  return columns;
+}
+
+bool HasSingleSuccessors(const CompactNondeterministicAutomaton& automaton) {
+  if (automaton.StartStates().size() > 1) {
+    return false;
+  }
+  for (std::uint32_t state = 0; state != automaton.StatesCount(); ++state) {
+    for (std::size_t column = 0; column != automaton.SymbolsCount(); ++column) {
+      if (automaton.SuccessorsEnd(state, column) - automaton.SuccessorsBegin(state, column) > 1) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// a disjoint set forest with path halving and union by size
+class UnionFind {
+ public:
+  explicit UnionFind(std::size_t size) : parent_(size), size_(size, 1) {
+    std::iota(parent_.begin(), parent_.end(), 0);
+  }
+
+  std::uint32_t Find(std::uint32_t item) {
+    while (parent_[item] != item) {
+      parent_[item] = parent_[parent_[item]];
+      item = parent_[item];
+    }
+    return item;
+  }
+
+  /// returns false if the items were in one set already
+  bool Unite(std::uint32_t left, std::uint32_t right) {
+    left = Find(left);
+    right = Find(right);
+    if (left == right) {
+      return false;
+    }
+    if (size_[left] < size_[right]) {
+      std::swap(left, right);
+    }
+    parent_[right] = left;
+    size_[left] += size_[right];
+    return true;
+  }
+
+ private:
+  std::vector<std::uint32_t> parent_;
+  std::vector<std::uint32_t> size_;
+};
+
+/**
+ * Hopcroft and Karp: the start states are merged and every merged pair merges its successors, the languages
+ * differ iff a pair disagrees on acceptance. Both automata are completed by a dead state of their own.
+ */
+bool AreEquivalentDeterministic(const CompactNondeterministicAutomaton& left,
+                                const CompactNondeterministicAutomaton& right, std::vector<Symbol>* counterexample) {
+  std::vector<Symbol> symbols;
+  for (std::size_t column = 0; column != left.SymbolsCount(); ++column) {
+    symbols.push_back(left.GetSymbol(column));
+  }
+  for (std::size_t column = 0; column != right.SymbolsCount(); ++column) {
+    symbols.push_back(right.GetSymbol(column));
+  }
+  std::sort(symbols.begin(), symbols.end());
+  symbols.erase(std::unique(symbols.begin(), symbols.end()), symbols.end());
+
+  // the states of right follow the states and the dead state of left
+  const auto left_dead = static_cast<std::uint32_t>(left.StatesCount());
+  const auto right_offset = left_dead + 1;
+  const auto right_dead = static_cast<std::uint32_t>(right.StatesCount());
+  auto next = [](const CompactNondeterministicAutomaton& automaton, std::uint32_t state, Symbol symbol) {
+    auto column = automaton.Column(symbol);
+    if (state == automaton.StatesCount() || column == automaton.SymbolsCount() ||
+        automaton.SuccessorsBegin(state, column) == automaton.SuccessorsEnd(state, column)) {
+      return static_cast<std::uint32_t>(automaton.StatesCount());
+    }
+    return *automaton.SuccessorsBegin(state, column);
+  };
+  auto is_final = [](const CompactNondeterministicAutomaton& automaton, std::uint32_t state) {
+    return state != automaton.StatesCount() && automaton.IsStateFinal(state);
+  };
+
+  UnionFind classes{right_offset + right_dead + 1};
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+  std::vector<Step> steps;
+  pairs.emplace_back(left.StartStates().empty() ? left_dead : left.StartStates().front(),
+                     right.StartStates().empty() ? right_dead : right.StartStates().front());
+  steps.push_back({kNone, 0});
+  classes.Unite(pairs.front().first, right_offset + pairs.front().second);
+  for (std::uint32_t id = 0; id != pairs.size(); ++id) {
+    const auto [p, q] = pairs[id];
+    if (is_final(left, p) != is_final(right, q)) {
+      Trace(steps, id, counterexample);
+      return false;
+    }
+    for (auto symbol : symbols) {
+      auto p_to = next(left, p, symbol);
+      auto q_to = next(right, q, symbol);
+      if (classes.Unite(p_to, right_offset + q_to)) {
+        pairs.emplace_back(p_to, q_to);
+        steps.push_back({id, symbol});
+      }
+    }
+  }
+  return true;
+}
+
+/// a state of left with a set of states of right that the words reaching it reach in right, as a range of sets_
+struct Macrostate {
+  std::uint32_t state;
+  std::uint32_t set_begin;
+  std::uint32_t set_end;
+  bool subsumed;
+};
+
+/**
+ * the forward antichain algorithm: a macrostate whose set includes the set of another macrostate of the same
+ * state of left is never needed, any counterexample from it is a counterexample from the other one as well
+ */
+bool IsIncluded(const CompactNondeterministicAutomaton& left, const CompactNondeterministicAutomaton& right,
+                std::vector<Symbol>* counterexample) {
+  const auto columns = MatchColumns(left, right);
+  std::vector<std::uint32_t> sets;
+  std::vector<Macrostate> macrostates;
+  std::vector<Step> steps;
+  std::vector<std::vector<std::uint32_t>> antichains(left.StatesCount());
+  std::queue<std::uint32_t> to_process;
+  auto includes = [&](const Macrostate& outer, const std::vector<std::uint32_t>& inner) {
+    return std::includes(sets.begin() + outer.set_begin, sets.begin() + outer.set_end, inner.begin(), inner.end());
+  };
+  // adds (state, set) unless it is subsumed, returns whether it is a counterexample
+  auto insert = [&](std::uint32_t state, const std::vector<std::uint32_t>& set, Step step) {
+    auto& antichain = antichains[state];
+    for (auto id : antichain) {
+      auto& other = macrostates[id];
+      if (std::includes(set.begin(), set.end(), sets.begin() + other.set_begin, sets.begin() + other.set_end)) {
+        return false;
+      }
+    }
+    antichain.erase(std::remove_if(antichain.begin(), antichain.end(),
+                                   [&](std::uint32_t id) {
+                                     if (!includes(macrostates[id], set)) {
+                                       return false;
+                                     }
+                                     macrostates[id].subsumed = true;
+                                     return true;
+                                   }),
+                    antichain.end());
+    const auto id = static_cast<std::uint32_t>(macrostates.size());
+    macrostates.push_back(Macrostate{state, static_cast<std::uint32_t>(sets.size()),
+                                     static_cast<std::uint32_t>(sets.size() + set.size()), false});
+    sets.insert(sets.end(), set.begin(), set.end());
+    steps.push_back(step);
+    antichain.push_back(id);
+    to_process.push(id);
+    if (left.IsStateFinal(state) &&
+        std::none_of(set.begin(), set.end(), [&](std::uint32_t q) { return right.IsStateFinal(q); })) {
+      Trace(steps, id, counterexample);
+      return true;
+    }
+    return false;
+  };
+
+  for (auto p : left.StartStates()) {
+    if (insert(p, right.StartStates(), Step{kNone, 0})) {
+      return false;
+    }
+  }
+  std::vector<std::uint32_t> set;
+  while (!to_process.empty()) {
+    const auto id = to_process.front();
+    to_process.pop();
+    if (macrostates[id].subsumed) {
+      continue;
+    }
+    const auto p = macrostates[id].state;
+    for (std::size_t column = 0; column != columns.size(); ++column) {
+      auto begin = left.SuccessorsBegin(p, column);
+      auto end = left.SuccessorsEnd(p, column);
+      if (begin == end) {
+        continue;
+      }
+      set.clear();
+      if (columns[column] != kNone) {
+        for (auto i = macrostates[id].set_begin; i != macrostates[id].set_end; ++i) {
+          set.insert(set.end(), right.SuccessorsBegin(sets[i], columns[column]),
+                     right.SuccessorsEnd(sets[i], columns[column]));
+        }
+        std::sort(set.begin(), set.end());
+        set.erase(std::unique(set.begin(), set.end()), set.end());
+      }
+      for (; begin != end; ++begin) {
+        if (insert(*begin, set, Step{id, left.GetSymbol(column)})) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+bool NondeterministicFiniteAutomaton::IsEmpty(std::vector<Symbol>* word) const {
+  const CompactNondeterministicAutomaton compact{*this};
+  std::vector<std::uint32_t> node_of(compact.StatesCount(), kNone);
+  std::vector<std::uint32_t> states;
+  std::vector<Step> steps;
+  for (auto state : compact.StartStates()) {
+    node_of[state] = static_cast<std::uint32_t>(states.size());
+    states.push_back(state);
+    steps.push_back({kNone, 0});
+  }
+  for (std::uint32_t id = 0; id != states.size(); ++id) {
+    const auto state = states[id];
+    if (compact.IsStateFinal(state)) {
+      Trace(steps, id, word);
+      return false;
+    }
+    for (std::size_t column = 0; column != compact.SymbolsCount(); ++column) {
+      for (auto to = compact.SuccessorsBegin(state, column), end = compact.SuccessorsEnd(state, column); to != end;
+           ++to) {
+        if (node_of[*to] == kNone) {
+          node_of[*to] = static_cast<std::uint32_t>(states.size());
+          states.push_back(*to);
+          steps.push_back({id, compact.GetSymbol(column)});
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool NondeterministicFiniteAutomaton::IsSubsetOf(const NondeterministicFiniteAutomaton& other,
+                                                 std::vector<Symbol>* counterexample) const {
+  return IsIncluded(CompactNondeterministicAutomaton{*this}, CompactNondeterministicAutomaton{other}, counterexample);
+}
+
+bool NondeterministicFiniteAutomaton::IsEquivalent(const NondeterministicFiniteAutomaton& other,
+                                                   std::vector<Symbol>* counterexample) const {
+  const CompactNondeterministicAutomaton left{*this};
+  const CompactNondeterministicAutomaton right{other};
+  if (HasSingleSuccessors(left) && HasSingleSuccessors(right)) {
+    return AreEquivalentDeterministic(left, right, counterexample);
+  }
+  return IsIncluded(left, right, counterexample) && IsIncluded(right, left, counterexample);
+}
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,115 @@
+#include <cppformlang/finite_automata/lazy_deterministic_automaton.h>
+#include <utils/hash.h>
+
+#include <algorithm>
+
+namespace cppformlang::finite_automata {
+
+std::size_t LazyDeterministicAutomaton::HashSubset::operator()(const std::vector<std::uint32_t>& value) const {
+  return utils::hash_range<std::uint32_t>(value.begin(), value.end());
+}
+
+LazyDeterministicAutomaton::LazyDeterministicAutomaton(const NondeterministicFiniteAutomaton& nfa,
+                                                       std::size_t memory_budget)
+    : nfa_{nfa},
+      alphabet_{nfa_},
+      columns_(alphabet_.ClassesCount()),
+      memory_budget_{memory_budget},
+      memory_usage_{0},
+      flushes_{0},
+      start_{kUnknown},
+      offsets_{0},
+      stamp_(nfa_.StatesCount(), 0),
+      generation_{0} {
+  for (std::uint32_t symbol_class = 0; symbol_class != columns_.size(); ++symbol_class) {
+    columns_[symbol_class] = nfa_.Column(alphabet_.Representative(symbol_class));
+  }
+}
+
+bool LazyDeterministicAutomaton::Accepts(const Symbol* begin, const Symbol* end) {
+  if (start_ == kUnknown) {
+    start_ = nfa_.StartStates().empty() ? kDead : AddState(nfa_.StartStates());
+  }
+  auto state = start_;
+  for (; begin != end && state != kDead; ++begin) {
+    if (*begin == kEpsilon) {
+      continue;
+    }
+    auto symbol_class = alphabet_.Class(*begin);
+    if (symbol_class == columns_.size()) {
+      return false;
+    }
+    state = Next(state, symbol_class);
+  }
+  return state != kDead && final_[state];
+}
+
+State LazyDeterministicAutomaton::Next(State state, std::uint32_t symbol_class) {
+  const auto columns = columns_.size();
+  const auto column = columns_[symbol_class];
+  if (auto next = next_[state * columns + symbol_class]; next != kUnknown) {
+    return next;
+  }
+  scratch_.clear();
+  if (++generation_ == 0) {
+    std::fill(stamp_.begin(), stamp_.end(), 0);
+    generation_ = 1;
+  }
+  for (auto i = offsets_[state]; i != offsets_[state + 1]; ++i) {
+    for (auto it = nfa_.SuccessorsBegin(subsets_[i], column), end = nfa_.SuccessorsEnd(subsets_[i], column);
+         it != end; ++it) {
+      if (stamp_[*it] != generation_) {
+        stamp_[*it] = generation_;
+        scratch_.push_back(*it);
+      }
+    }
+  }
+  if (scratch_.empty()) {
+    next_[state * columns + symbol_class] = kDead;
+    return kDead;
+  }
+  std::sort(scratch_.begin(), scratch_.end());
+  if (auto it = ids_.find(scratch_); it != ids_.end()) {
+    next_[state * columns + symbol_class] = it->second;
+    return it->second;
+  }
+  // the new state does not fit, start over with an empty cache keeping only the target
+  if (memory_usage_ + StateSize(scratch_.size()) > memory_budget_) {
+    Flush();
+    return AddState(scratch_);
+  }
+  auto to = AddState(scratch_);
+  next_[state * columns + symbol_class] = to;
+  return to;
+}
+
+std::size_t LazyDeterministicAutomaton::StateSize(std::size_t subset_size) const {
+  // the subset is stored twice, in the arena and as the key, plus the row and the hash node
+  return subset_size * sizeof(std::uint32_t) * 2 + columns_.size() * sizeof(State) + 64;
+}
+
+State LazyDeterministicAutomaton::AddState(const std::vector<std::uint32_t>& subset) {
+  const auto columns = columns_.size();
+  auto state = static_cast<State>(CachedStatesCount());
+  ids_.emplace(subset, state);
+  subsets_.insert(subsets_.end(), subset.begin(), subset.end());
+  offsets_.push_back(subsets_.size());
+  next_.resize(next_.size() + columns, kUnknown);
+  final_.push_back(std::any_of(subset.begin(), subset.end(),
+                               [this](std::uint32_t nfa_state) { return nfa_.IsStateFinal(nfa_state); }));
+  memory_usage_ += StateSize(subset.size());
+  return state;
+}
+
+void LazyDeterministicAutomaton::Flush() {
+  ++flushes_;
+  ids_.clear();
+  offsets_.assign(1, 0);
+  subsets_.clear();
+  next_.clear();
+  final_.clear();
+  memory_usage_ = 0;
+  start_ = kUnknown;
+}
+
+}  // namespace cppformlang::finite_automata
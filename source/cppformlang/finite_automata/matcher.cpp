@@ -0,0 +1,85 @@
+#include <cppformlang/finite_automata/matcher.h>
+
+#include <algorithm>
+
+namespace cppformlang::finite_automata {
+
+Matcher::Matcher(const DenseDeterministicAutomaton& dfa)
+    : dfa_{&dfa}, nfa_{nullptr}, state_{dfa.StartState()}, generation_{0} {}
+
+Matcher::Matcher(const CompactNondeterministicAutomaton& nfa)
+    : dfa_{nullptr}, nfa_{&nfa}, state_{DenseDeterministicAutomaton::kDeadState}, stamp_(nfa.StatesCount(), 0),
+      generation_{0} {
+  current_.reserve(nfa.StatesCount());
+  next_.reserve(nfa.StatesCount());
+  Reset();
+}
+
+bool Matcher::Feed(const Symbol* begin, const Symbol* end) {
+  if (nfa_ != nullptr) {
+    return FeedNondeterministic(begin, end);
+  }
+  const auto columns = dfa_->ColumnsCount();
+  auto state = state_;
+  for (; begin != end && state != DenseDeterministicAutomaton::kDeadState; ++begin) {
+    if (*begin == kEpsilon) {
+      continue;
+    }
+    auto column = dfa_->Column(*begin);
+    state = column == columns ? DenseDeterministicAutomaton::kDeadState : dfa_->Next(state, column);
+  }
+  state_ = state;
+  return state != DenseDeterministicAutomaton::kDeadState;
+}
+
+bool Matcher::FeedNondeterministic(const Symbol* begin, const Symbol* end) {
+  for (; begin != end && !current_.empty(); ++begin) {
+    if (*begin == kEpsilon) {
+      continue;
+    }
+    auto column = nfa_->Column(*begin);
+    next_.clear();
+    if (column != nfa_->SymbolsCount()) {
+      if (++generation_ == 0) {
+        std::fill(stamp_.begin(), stamp_.end(), 0);
+        generation_ = 1;
+      }
+      for (auto from : current_) {
+        for (auto it = nfa_->SuccessorsBegin(from, column), last = nfa_->SuccessorsEnd(from, column); it != last;
+             ++it) {
+          if (stamp_[*it] != generation_) {
+            stamp_[*it] = generation_;
+            next_.push_back(*it);
+          }
+        }
+      }
+    }
+    current_.swap(next_);
+  }
+  return !current_.empty();
+}
+
+bool Matcher::IsAccepting() const {
+  if (nfa_ != nullptr) {
+    return std::any_of(current_.begin(), current_.end(),
+                       [this](std::uint32_t state) { return nfa_->IsStateFinal(state); });
+  }
+  return state_ != DenseDeterministicAutomaton::kDeadState && dfa_->IsStateFinal(state_);
+}
+
+bool Matcher::IsDead() const {
+  if (nfa_ != nullptr) {
+    return current_.empty();
+  }
+  return state_ == DenseDeterministicAutomaton::kDeadState;
+}
+
+void Matcher::Reset() {
+  if (nfa_ != nullptr) {
+    current_.assign(nfa_->StartStates().begin(), nfa_->StartStates().end());
+    return;
+  }
+  state_ = dfa_->StartState();
+}
+
+}  // namespace cppformlang::finite_automata
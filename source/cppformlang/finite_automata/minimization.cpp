@@ -0,0 +1,278 @@
+#include <cppformlang/finite_automata/minimization.h>
+#include <utils/hash.h>
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+constexpr auto kDead = DenseDeterministicAutomaton::kDeadState;
+
+/// the target of a transition in the completed automaton
+State CompletedNext(const DenseDeterministicAutomaton& dfa, State state, std::size_t column) {
+  auto states_count = static_cast<State>(dfa.StatesCount());
+  if (state == states_count) {
+    return states_count;
+  }
+  auto to = dfa.Next(state, column);
+  return to == kDead ? states_count : to;
+}
+
+/// renumbers labels to 0..k-1 keeping the order of first occurrence
+std::vector<State> Normalize(const std::vector<State>& labels, std::size_t count) {
+  std::unordered_map<State, State> ids;
+  std::vector<State> blocks(count);
+  for (std::size_t state = 0; state != count; ++state) {
+    auto label = state < labels.size() ? labels[state] : 0;
+    blocks[state] = ids.emplace(label, static_cast<State>(ids.size())).first->second;
+  }
+  return blocks;
+}
+
+/**
+ * \brief States grouped by block in one array, every block is a range of it
+ *
+ * \details Marked states are moved to the beginning of their block, so a
+ * split is a cut of the range.
+ */
+class Partition {
+ public:
+  Partition(const std::vector<State>& blocks, std::size_t blocks_count)
+      : elements_(blocks.size()), location_(blocks.size()), block_(blocks), begin_(blocks_count + 1, 0) {
+    for (auto block : blocks) {
+      ++begin_[block + 1];
+    }
+    std::partial_sum(begin_.begin(), begin_.end(), begin_.begin());
+    end_.assign(begin_.begin() + 1, begin_.end());
+    begin_.pop_back();
+    auto fill = begin_;
+    for (State state = 0; state != blocks.size(); ++state) {
+      location_[state] = fill[blocks[state]]++;
+      elements_[location_[state]] = state;
+    }
+    marked_.assign(blocks_count, 0);
+  }
+
+  std::size_t BlocksCount() const { return begin_.size(); }
+  std::size_t Size(State block) const { return end_[block] - begin_[block]; }
+  State Block(State state) const { return block_[state]; }
+  const State* Begin(State block) const { return elements_.data() + begin_[block]; }
+  const State* End(State block) const { return elements_.data() + end_[block]; }
+
+  /// returns true if it is the first mark in the block
+  bool Mark(State state) {
+    auto block = block_[state];
+    auto position = location_[state];
+    auto marked_end = begin_[block] + marked_[block];
+    if (position < marked_end) {
+      return false;
+    }
+    std::swap(elements_[position], elements_[marked_end]);
+    location_[elements_[position]] = position;
+    location_[state] = marked_end;
+    return marked_[block]++ == 0;
+  }
+
+  /// splits the marked part off, returns the new block or kDead when nothing was split
+  State Split(State block) {
+    auto marked = marked_[block];
+    marked_[block] = 0;
+    if (marked == Size(block)) {
+      return kDead;
+    }
+    auto new_block = static_cast<State>(begin_.size());
+    begin_.push_back(begin_[block]);
+    end_.push_back(begin_[block] + marked);
+    marked_.push_back(0);
+    begin_[block] += marked;
+    for (auto i = begin_[new_block]; i != end_[new_block]; ++i) {
+      block_[elements_[i]] = new_block;
+    }
+    return new_block;
+  }
+
+  std::vector<State> Blocks() const { return block_; }
+
+ private:
+  std::vector<State> elements_;
+  std::vector<std::size_t> location_;
+  std::vector<State> block_;
+  std::vector<std::size_t> begin_;
+  std::vector<std::size_t> end_;
+  std::vector<std::size_t> marked_;
+};
+
+}  // namespace
+
+std::vector<State> FinalLabels(const DenseDeterministicAutomaton& dfa) {
+  std::vector<State> labels(dfa.StatesCount());
+  for (State state = 0; state != labels.size(); ++state) {
+    labels[state] = dfa.IsStateFinal(state) ? 1 : 0;
+  }
+  return labels;
+}
+
+std::vector<State> HopcroftPartition(const DenseDeterministicAutomaton& dfa, const std::vector<State>& labels) {
+  const auto count = dfa.StatesCount() + 1;
+  const auto columns = dfa.ColumnsCount();
+  auto initial = Normalize(labels, count);
+  auto initial_count = static_cast<std::size_t>(*std::max_element(initial.begin(), initial.end())) + 1;
+  Partition partition{initial, initial_count};
+
+  // inverse[inverse_begin[column * count + to] ...] are the sources of `to` by `column`
+  std::vector<std::size_t> inverse_begin(columns * count + 1, 0);
+  for (State from = 0; from != count; ++from) {
+    for (std::size_t column = 0; column != columns; ++column) {
+      ++inverse_begin[column * count + CompletedNext(dfa, from, column) + 1];
+    }
+  }
+  std::partial_sum(inverse_begin.begin(), inverse_begin.end(), inverse_begin.begin());
+  std::vector<State> inverse(inverse_begin.back());
+  {
+    auto fill = inverse_begin;
+    for (State from = 0; from != count; ++from) {
+      for (std::size_t column = 0; column != columns; ++column) {
+        inverse[fill[column * count + CompletedNext(dfa, from, column)]++] = from;
+      }
+    }
+  }
+
+  // all initial blocks but the largest one are splitters
+  std::vector<State> worklist;
+  std::vector<bool> in_worklist(initial_count, false);
+  State largest = 0;
+  for (State block = 1; block != initial_count; ++block) {
+    if (partition.Size(block) > partition.Size(largest)) {
+      largest = block;
+    }
+  }
+  for (State block = 0; block != initial_count; ++block) {
+    if (block != largest) {
+      worklist.push_back(block);
+      in_worklist[block] = true;
+    }
+  }
+
+  std::vector<State> splitter;
+  std::vector<State> touched;
+  while (!worklist.empty()) {
+    auto block = worklist.back();
+    worklist.pop_back();
+    in_worklist[block] = false;
+    splitter.assign(partition.Begin(block), partition.End(block));
+    for (std::size_t column = 0; column != columns; ++column) {
+      for (auto to : splitter) {
+        auto row = column * count + to;
+        for (auto i = inverse_begin[row]; i != inverse_begin[row + 1]; ++i) {
+          if (partition.Mark(inverse[i])) {
+            touched.push_back(partition.Block(inverse[i]));
+          }
+        }
+      }
+      for (auto split : touched) {
+        auto new_block = partition.Split(split);
+        if (new_block == kDead) {
+          continue;
+        }
+        in_worklist.push_back(false);
+        if (in_worklist[split]) {
+          worklist.push_back(new_block);
+          in_worklist[new_block] = true;
+        } else {
+          auto smaller = partition.Size(new_block) < partition.Size(split) ? new_block : split;
+          worklist.push_back(smaller);
+          in_worklist[smaller] = true;
+        }
+      }
+      touched.clear();
+    }
+  }
+  return partition.Blocks();
+}
+
+std::vector<State> MoorePartition(const DenseDeterministicAutomaton& dfa, const std::vector<State>& labels) {
+  const auto count = dfa.StatesCount() + 1;
+  const auto columns = dfa.ColumnsCount();
+  auto blocks = Normalize(labels, count);
+  auto blocks_count = static_cast<std::size_t>(*std::max_element(blocks.begin(), blocks.end())) + 1;
+
+  struct HashSignature {
+    std::size_t operator()(const std::vector<State>& value) const {
+      return utils::hash_range<State>(value.begin(), value.end());
+    }
+  };
+  std::vector<State> signature(columns + 1);
+  std::vector<State> next_blocks(count);
+  while (true) {
+    std::unordered_map<std::vector<State>, State, HashSignature> ids;
+    for (State state = 0; state != count; ++state) {
+      signature[0] = blocks[state];
+      for (std::size_t column = 0; column != columns; ++column) {
+        signature[column + 1] = blocks[CompletedNext(dfa, state, column)];
+      }
+      next_blocks[state] = ids.emplace(signature, static_cast<State>(ids.size())).first->second;
+    }
+    blocks.swap(next_blocks);
+    if (ids.size() == blocks_count) {
+      return blocks;
+    }
+    blocks_count = ids.size();
+  }
+}
+
+DenseDeterministicAutomaton Quotient(const DenseDeterministicAutomaton& dfa, const std::vector<State>& blocks,
+                                     std::vector<State>* state_ids) {
+  const auto states_count = static_cast<State>(dfa.StatesCount());
+  const auto columns = dfa.ColumnsCount();
+  const auto dead_block = blocks[states_count];
+  if (state_ids != nullptr) {
+    state_ids->assign(states_count, kDead);
+  }
+  if (dfa.StartState() == kDead || blocks[dfa.StartState()] == dead_block) {
+    return DenseDeterministicAutomaton{dfa.Alphabet(), {}, {}, kDead};
+  }
+
+  // any member represents its block, the breadth-first order gives the new ids
+  std::unordered_map<State, State> ids;
+  std::vector<State> representatives;
+  std::queue<State> to_process;
+  ids.emplace(blocks[dfa.StartState()], 0);
+  representatives.push_back(dfa.StartState());
+  to_process.push(dfa.StartState());
+  std::vector<State> next;
+  std::vector<State> final_states;
+  while (!to_process.empty()) {
+    auto from = to_process.front();
+    to_process.pop();
+    if (dfa.IsStateFinal(from)) {
+      final_states.push_back(ids[blocks[from]]);
+    }
+    for (std::size_t column = 0; column != columns; ++column) {
+      auto to = dfa.Next(from, column);
+      if (to == kDead || blocks[to] == dead_block) {
+        next.push_back(kDead);
+        continue;
+      }
+      auto [it, inserted] = ids.emplace(blocks[to], static_cast<State>(representatives.size()));
+      if (inserted) {
+        representatives.push_back(to);
+        to_process.push(to);
+      }
+      next.push_back(it->second);
+    }
+  }
+  if (state_ids != nullptr) {
+    for (State state = 0; state != states_count; ++state) {
+      if (auto it = ids.find(blocks[state]); it != ids.end()) {
+        (*state_ids)[state] = it->second;
+      }
+    }
+  }
+  return DenseDeterministicAutomaton{dfa.Alphabet(), std::move(next), final_states, 0};
+}
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,38 @@
+#include <cppformlang/finite_automata/nondeterministic_acceptor.h>
+
+#include <utility>
+
+namespace cppformlang::finite_automata {
+
+NondeterministicAcceptor::NondeterministicAcceptor(NondeterministicFiniteAutomaton nfa, AcceptsEngine engine)
+    : nfa_{std::move(nfa)} {
+  if (engine != AcceptsEngine::kBitParallel) {
+    return;
+  }
+  auto states_count = nfa_.StatesCount();
+  if (states_count <= BitParallelAutomaton<1>::kMaxStates) {
+    engine_.emplace<BitParallelAutomaton<1>>(nfa_);
+  } else if (states_count <= BitParallelAutomaton<2>::kMaxStates) {
+    engine_.emplace<BitParallelAutomaton<2>>(nfa_);
+  } else if (states_count <= BitParallelAutomaton<4>::kMaxStates) {
+    engine_.emplace<BitParallelAutomaton<4>>(nfa_);
+  }
+}
+
+bool NondeterministicAcceptor::Accepts(const Symbol* begin, const Symbol* end) const {
+  return std::visit(
+      [&](const auto& engine) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(engine)>, std::monostate>) {
+          return nfa_.Accepts(begin, end);
+        } else {
+          return engine.Accepts(begin, end);
+        }
+      },
+      engine_);
+}
+
+AcceptsEngine NondeterministicAcceptor::Engine() const {
+  return std::holds_alternative<std::monostate>(engine_) ? AcceptsEngine::kGeneric : AcceptsEngine::kBitParallel;
+}
+
+}  // namespace cppformlang::finite_automata
@@ -1,11 +1,18 @@
+#include <cppformlang/finite_automata/alphabet_partition.h>
+#include <cppformlang/finite_automata/compact_nondeterministic_automaton.h>
+#include <cppformlang/finite_automata/dense_deterministic_automaton.h>
 #include <cppformlang/finite_automata/nondeterministic_finite_automaton.h>
-#include <utils/hash.h>
+#include <cppformlang/finite_automata/state_set.h>
+#include <cppformlang/finite_automata/stats.h>
 
 #include <algorithm>
 #include <cassert>
+#include <memory>
+#include <memory_resource>
 #include <set>
 #include <stack>
 #include <string>
+#include <vector>
 
 namespace cppformlang::finite_automata {
 
@@ -13,8 +20,12 @@ bool NondeterministicFiniteAutomaton::IsDeterministic() const {
   if (start_states_.size() > 1 || !FiniteAutomaton::IsDeterministic()) {
     return false;
   }
-  return std::all_of(states_.begin(), states_.end(),
-                     [this](const auto& state) { return Eclose(state.first).size() <= 1; });
+  // with a single successor by every symbol a closure grows only by an epsilon transition to another state
+  bool result = true;
+  if (symbols_.find(kEpsilon) != symbols_.end()) {
+    ForeachTransition([&](State from, Symbol by, State to) { result = result && (by != kEpsilon || from == to); });
+  }
+  return result;
 }
 
 std::unordered_set<State> NondeterministicFiniteAutomaton::Eclose(State state) const {
@@ -33,125 +44,167 @@ std::unordered_set<State> NondeterministicFiniteAutomaton::Eclose(State state) c
       }
     }
   }
+  stats::RecordClosure(processed.size());
   return processed;
 }
 
-struct HashStates {
-  std::size_t operator()(const std::unordered_set<State>& value) const {
-    return utils::hash_range<State>(value.begin(), value.end());
-  }
-};
-
 NondeterministicFiniteAutomaton NondeterministicFiniteAutomaton::ToDeterministic() const {
+  stats::ScopedPhase phase{Phase::kToDeterministic};
   NondeterministicFiniteAutomaton dfa;
   if (start_states_.empty()) {
     assert(states_.empty());
     return dfa;
   }
-  State state = 1;
-
-  std::unordered_set<State> current = Eclose(*start_states_.begin());
-  std::unordered_set<State> next;
-
-  std::unordered_map<std::unordered_set<State>, State, HashStates> processed;
-  processed.emplace(current, state);
-  std::stack<std::tuple<std::unordered_set<State>, State>> to_process;
-  to_process.emplace(current, state);
+  const CompactNondeterministicAutomaton compact{*this};
+  // the subsets are built once per class of symbols, by the column of its smallest symbol
+  const AlphabetPartition alphabet{compact};
+  std::vector<std::size_t> columns(alphabet.ClassesCount());
+  for (std::uint32_t symbol_class = 0; symbol_class != columns.size(); ++symbol_class) {
+    columns[symbol_class] = compact.Column(alphabet.Representative(symbol_class));
+  }
+  auto is_final = [&](const StateSet& set) {
+    bool result = false;
+    set.ForeachState([&](std::uint32_t state) { result = result || compact.IsStateFinal(state); });
+    return result;
+  };
 
-  while (!to_process.empty()) {
-    auto [current, from_state] = to_process.top();
-    to_process.pop();
-    for (auto& [symbol, _] : symbols_) {
+  // subsets are numbered in breadth-first order, the same as ToDeterministic(threads) does
+  StateSetTable processed{compact.StatesCount()};
+  StateSet next{compact.StatesCount()};
+  for (auto state : compact.StartStates()) {
+    next.Insert(state);
+  }
+  processed.Intern(next);
+  std::vector<State> dfa_finals;
+  if (is_final(next)) {
+    dfa_finals.push_back(1);
+  }
+  std::vector<std::uint32_t> current;
+  for (std::uint32_t from_id = 0; from_id != processed.Size(); ++from_id) {
+    current.clear();
+    processed.ForeachState(from_id, [&](std::uint32_t state) { current.push_back(state); });
+    for (std::uint32_t symbol_class = 0; symbol_class != columns.size(); ++symbol_class) {
+      const auto column = columns[symbol_class];
+      next.Clear();
       for (auto from : current) {
-        if (auto to_set = (*this)(from, symbol)) {
-          next.insert(to_set->begin(), to_set->end());
+        for (auto it = compact.SuccessorsBegin(from, column), end = compact.SuccessorsEnd(from, column); it != end;
+             ++it) {
+          next.Insert(*it);
         }
       }
-      bool is_final = false;
-      for (auto to : next) {
-        for (auto to_close : Eclose(to)) {
-          next.insert(to_close);
-          if (!is_final && IsStateFinal(to_close)) {
-            is_final = true;
-          }
-        }
-      }
-      if (next.empty()) {
+      if (next.Empty()) {
         continue;
       }
-      State to_state;
-      if (auto it_to = processed.find(next); it_to != processed.end()) {
-        to_state = it_to->second;
-      } else {
-        processed.emplace_hint(it_to, next, from_state);
-        to_state = ++state;
-        to_process.emplace(next, to_state);
-      }
-      dfa.AddTransition(from_state, symbol, to_state);
-      if (is_final) {
-        dfa.SetFinalState(to_state, is_final);
+      auto [to_id, inserted] = processed.Intern(next);
+      if (inserted && is_final(next)) {
+        dfa_finals.push_back(to_id + 1);
       }
+      alphabet.ForeachSymbolOf(symbol_class, [&](Symbol symbol) { dfa.AddTransition(from_id + 1, symbol, to_id + 1); });
     }
   }
+  // the start subset may have no transitions
+  dfa.AddState(1);
   dfa.SetStartState(1, true);
+  for (auto final_state : dfa_finals) {
+    dfa.AddState(final_state);
+    dfa.SetFinalState(final_state, true);
+  }
+  if constexpr (kStatsEnabled) {
+    stats::RecordBytes(processed.MemoryUsage() + dfa.MemoryUsage());
+  }
   return dfa;
 }
+
+std::shared_ptr<const EpsilonClosureTable> NondeterministicFiniteAutomaton::Closures() const {
+  auto closures = std::atomic_load(&closures_);
+  if (!closures || closures->modifications != modifications_) {
+    // concurrent calls may build it more than once, one of the equal tables is kept
+    closures = std::make_shared<const CachedClosures>(CachedClosures{modifications_, EpsilonClosureTable{*this}});
+    std::atomic_store(&closures_, closures);
+  }
+  return {closures, &closures->table};
+}
+
 bool NondeterministicFiniteAutomaton::Accepts(const Symbol* begin, const Symbol* end) const {
+  stats::ScopedPhase phase{Phase::kAccepts};
+  const auto closures = Closures();
   std::unordered_set<State> current_states;
   for (auto start : start_states_) {
-    auto start_set = Eclose(start);
-    current_states.insert(start_set.begin(), start_set.end());
+    closures->ForeachInClosure(start, [&](State state) { current_states.insert(state); });
   }
-  for (; begin != end; ++begin) {
+  std::unordered_set<State> next;
+  for (; begin != end && !current_states.empty(); ++begin) {
     if (*begin == kEpsilon) {
       continue;
     }
-    auto next = GetNextStates(current_states, *begin);
-    current_states.clear();
-    for (auto start : next) {
-      auto start_set = Eclose(start);
-      current_states.insert(start_set.begin(), start_set.end());
-    }
+    next.clear();
+    GetNextStates(*closures, current_states, *begin, next);
+    current_states.swap(next);
   }
   return std::any_of(current_states.begin(), current_states.end(),
                      [this](const auto& state) { return final_states_.find(state) != final_states_.end(); });
 }
 
-std::unordered_set<State> NondeterministicFiniteAutomaton::GetNextStates(
-    const std::unordered_set<State>& current_states, Symbol symbol) const {
-  std::unordered_set<State> next_states;
+void NondeterministicFiniteAutomaton::GetNextStates(const EpsilonClosureTable& closures,
+                                                    const std::unordered_set<State>& current_states, Symbol symbol,
+                                                    std::unordered_set<State>& next_states) const {
   for (auto current_state : current_states) {
     if (auto next_states_temp = (*this)(current_state, symbol)) {
-      next_states.insert(next_states_temp->begin(), next_states_temp->end());
+      for (auto next_state : *next_states_temp) {
+        closures.ForeachInClosure(next_state, [&](State state) { next_states.insert(state); });
+      }
+    }
+  }
+}
+
+NondeterministicFiniteAutomaton NondeterministicFiniteAutomaton::RemoveEpsilon() const {
+  const auto closures = Closures();
+  std::unordered_map<State, std::vector<std::pair<Symbol, State>>> adjacency;
+  ForeachTransition([&](State from, Symbol by, State to) {
+    if (by != kEpsilon) {
+      adjacency[from].emplace_back(by, to);
+    }
+  });
+
+  NondeterministicFiniteAutomaton nfa;
+  std::unordered_set<State> processed{start_states_.begin(), start_states_.end()};
+  std::stack<State> to_process;
+  for (auto start : start_states_) {
+    to_process.push(start);
+  }
+  std::vector<State> finals;
+  while (!to_process.empty()) {
+    auto from = to_process.top();
+    to_process.pop();
+    bool is_final = false;
+    closures->ForeachInClosure(from, [&](State middle) {
+      is_final = is_final || IsStateFinal(middle);
+      if (auto it = adjacency.find(middle); it != adjacency.end()) {
+        for (auto& [by, to] : it->second) {
+          nfa.AddTransition(from, by, to);
+          if (processed.insert(to).second) {
+            to_process.push(to);
+          }
+        }
+      }
+    });
+    if (is_final) {
+      finals.push_back(from);
     }
   }
-  return next_states;
+  // a start state may have no transitions left
+  for (auto start : start_states_) {
+    nfa.AddState(start);
+    nfa.SetStartState(start, true);
+  }
+  for (auto state : finals) {
+    nfa.SetFinalState(state, true);
+  }
+  return nfa;
 }
 
 NondeterministicFiniteAutomaton NondeterministicFiniteAutomaton::Minimize() const {
-  auto dfa = ToDeterministic();
-  // auto reachable_states = GetReachableStates();
-  // std::unordered_set<State> states;
-  // std::set_intersection(states_.begin(), states_.end(),
-  //                       reachable_states.begin(), reachable_states.end(),
-  //                       states.begin());
-  // auto partition = GetPartition();
-  // auto groups = GetGroups();
-  // std::unordered_map<State, State> to_new_states;
-  // State new_state = 0;
-  // for (const auto& group : groups) {
-  //   for (auto state : group) {
-  //     to_new_states[state] = new_state;
-  //   }
-  //   ++new_state;
-  // }
-  // for (auto state : start_states_) {
-  //   dfa.SetStartState(to_new_states[state], true);
-  // }
-  // for (auto state : start_states_) {
-  //   dfa.SetFinalState(to_new_states[state], true);
-  // }
-  return dfa;
+  return DenseDeterministicAutomaton{*this}.Minimize().ToNondeterministic();
 }
 
 void NondeterministicFiniteAutomaton::Union(const FiniteAutomaton& other) {
@@ -165,6 +218,8 @@ void NondeterministicFiniteAutomaton::Union(const FiniteAutomaton& other) {
   other.ForeachTransition([&](const auto& other_from, const auto& by, const auto& other_to) {
     AddTransition(other_from + max_state_number, by, other_to + max_state_number);
   });
+  // a start or final state of other may have no transitions
+  other.ForeachState([&](const auto& state) { AddState(state + max_state_number); });
 
   start_states_.reserve(start_states_.size() + other.StartStatesCount());
   other.ForeachStartState([&](const auto& state) { start_states_.insert(state + max_state_number); });
@@ -183,6 +238,8 @@ void NondeterministicFiniteAutomaton::Concatenate(const FiniteAutomaton& other)
   other.ForeachTransition([&](const auto& other_from, const auto& by, const auto& other_to) {
     AddTransition(other_from + max_state_number, by, other_to + max_state_number);
   });
+  // a start or final state of other may have no transitions
+  other.ForeachState([&](const auto& state) { AddState(state + max_state_number); });
 
   other.ForeachStartState([&](const auto& other_to) {
     auto to = other_to + max_state_number;
@@ -195,9 +252,39 @@ void NondeterministicFiniteAutomaton::Concatenate(const FiniteAutomaton& other)
 }
 
 void NondeterministicFiniteAutomaton::KleeneStar() {
+  if (start_states_.empty()) {
+    return;
+  }
+  State max_state_number = 0;
+  ForeachState([&](const auto& state) {
+    if (max_state_number < state) {
+      max_state_number = state;
+    }
+  });
+
   ForeachFinalState(
       [this](const auto& from) { ForeachStartState([&](const auto& to) { AddTransition(from, kEpsilon, to); }); });
-  final_states_.insert(start_states_.begin(), start_states_.end());
+  // a new final start state, an old one may be entered again by a loop and must not accept the prefix read there
+  const auto start = max_state_number + 1;
+  ForeachStartState([&](const auto& to) { AddTransition(start, kEpsilon, to); });
+  start_states_.clear();
+  start_states_.insert(start);
+  final_states_.insert(start);
+}
+
+NondeterministicFiniteAutomaton NondeterministicFiniteAutomaton::Reverse() const {
+  NondeterministicFiniteAutomaton reversed;
+  ForeachTransition([&](State from, Symbol by, State to) { reversed.AddTransition(to, by, from); });
+  // a start or final state may have no transitions
+  ForeachFinalState([&](State state) {
+    reversed.AddState(state);
+    reversed.SetStartState(state, true);
+  });
+  ForeachStartState([&](State state) {
+    reversed.AddState(state);
+    reversed.SetFinalState(state, true);
+  });
+  return reversed;
 }
 
 static std::string ToPostfix(const std::string& regex) {
@@ -247,12 +334,20 @@ static std::string ToPostfix(const std::string& regex) {
 }
 
 NondeterministicFiniteAutomaton NondeterministicFiniteAutomaton::FromRegex(const std::string& regex) {
+  std::pmr::monotonic_buffer_resource arena;
+  const auto automaton = FromRegex(regex, &arena);
+  // the copy is allocated from the default resource and outlives the arena
+  return NondeterministicFiniteAutomaton{automaton};
+}
+
+NondeterministicFiniteAutomaton NondeterministicFiniteAutomaton::FromRegex(const std::string& regex,
+                                                                           std::pmr::memory_resource* resource) {
   auto postfix_regex = ToPostfix(regex);
   std::stack<NondeterministicFiniteAutomaton> operands;
   bool ignore = false;
   for (auto begin = postfix_regex.begin(), end = postfix_regex.end(); begin != end; ++begin) {
     if (ignore) {
-      operands.push(NondeterministicFiniteAutomaton{*begin});
+      operands.push(NondeterministicFiniteAutomaton{*begin, resource});
       ignore = false;
       continue;
     }
@@ -264,27 +359,28 @@ NondeterministicFiniteAutomaton NondeterministicFiniteAutomaton::FromRegex(const
         operands.top().KleeneStar();
       } break;
       case '+': {
-        auto right = operands.top();
+        auto right = std::move(operands.top());
         operands.pop();
         operands.top().Concatenate(right);
       } break;
       case '|': {
-        auto right = operands.top();
+        auto right = std::move(operands.top());
         operands.pop();
         operands.top().Union(right);
       } break;
       default: {
-        operands.push(NondeterministicFiniteAutomaton{*begin});
+        operands.push(NondeterministicFiniteAutomaton{*begin, resource});
       } break;
     }
   }
   if (operands.empty()) {
-    return {};
+    return NondeterministicFiniteAutomaton{resource};
   }
-  return operands.top();
+  return std::move(operands.top());
 }
 
-NondeterministicFiniteAutomaton::NondeterministicFiniteAutomaton(char c) {
+NondeterministicFiniteAutomaton::NondeterministicFiniteAutomaton(char c, std::pmr::memory_resource* resource)
+    : FiniteAutomaton{resource} {
   AddTransition(1, c, 2);
   start_states_.insert(1);
   final_states_.insert(2);
@@ -292,4 +388,9 @@ NondeterministicFiniteAutomaton::NondeterministicFiniteAutomaton(char c) {
 
 NondeterministicFiniteAutomaton::NondeterministicFiniteAutomaton() = default;
 
+NondeterministicFiniteAutomaton::NondeterministicFiniteAutomaton(std::pmr::memory_resource* resource)
+    : FiniteAutomaton{resource} {}
+
+NondeterministicFiniteAutomaton::NondeterministicFiniteAutomaton(OwnArena arena) : FiniteAutomaton{arena} {}
+
 }  // namespace cppformlang::finite_automata
@@ -1,7 +1,39 @@
 #include <cppformlang/finite_automata/nondeterministic_transitions.h>
+#include <utils/memory_usage.h>
+
+#include <utility>
 
 namespace cppformlang::finite_automata {
 
+NondeterministicTransitions::NondeterministicTransitions() = default;
+
+NondeterministicTransitions::NondeterministicTransitions(std::pmr::memory_resource* resource)
+    : transitions_{resource} {}
+
+NondeterministicTransitions::NondeterministicTransitions(OwnArena)
+    : arena_{std::make_shared<std::pmr::monotonic_buffer_resource>()}, transitions_{arena_.get()} {}
+
+// a copy never shares the arena, pmr containers copy into the default resource
+NondeterministicTransitions::NondeterministicTransitions(const NondeterministicTransitions& other)
+    : transitions_{other.transitions_} {}
+
+// the containers keep their resource when moved, the moved-from ones too, so both objects own the arena
+NondeterministicTransitions::NondeterministicTransitions(NondeterministicTransitions&& other) noexcept
+    : arena_{other.arena_}, transitions_{std::move(other.transitions_)} {}
+
+// assignments keep the resource of the receiver and copy the elements into it
+NondeterministicTransitions& NondeterministicTransitions::operator=(const NondeterministicTransitions& other) {
+  transitions_ = other.transitions_;
+  return *this;
+}
+
+NondeterministicTransitions& NondeterministicTransitions::operator=(NondeterministicTransitions&& other) {
+  transitions_ = std::move(other.transitions_);
+  return *this;
+}
+
+NondeterministicTransitions::~NondeterministicTransitions() = default;
+
 bool NondeterministicTransitions::AddTransition(State from, Symbol by, State to) {
   return transitions_[from][by].insert(to).second;
 }
@@ -41,7 +73,18 @@ size_t NondeterministicTransitions::TransitionsCount() const {
   return size;
 }
 
-const std::unordered_set<State>* NondeterministicTransitions::operator()(State from, Symbol by) const {
+std::size_t NondeterministicTransitions::MemoryUsage() const {
+  auto bytes = utils::hash_container_memory(transitions_);
+  for (auto& [_, from] : transitions_) {
+    bytes += utils::hash_container_memory(from);
+    for (auto& [_, by] : from) {
+      bytes += utils::hash_container_memory(by);
+    }
+  }
+  return bytes;
+}
+
+const std::pmr::unordered_set<State>* NondeterministicTransitions::operator()(State from, Symbol by) const {
   auto it_from = transitions_.find(from);
   if (it_from == transitions_.end()) {
     return nullptr;
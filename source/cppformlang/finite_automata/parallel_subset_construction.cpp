@@ -0,0 +1,275 @@
+#include <cppformlang/finite_automata/alphabet_partition.h>
+#include <cppformlang/finite_automata/compact_nondeterministic_automaton.h>
+#include <cppformlang/finite_automata/nondeterministic_finite_automaton.h>
+#include <cppformlang/finite_automata/state_set.h>
+#include <cppformlang/finite_automata/stats.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+using Subset = std::vector<std::uint32_t>;
+
+struct Task {
+  Subset subset;
+  std::uint32_t id;
+};
+
+/// a deque owned by one worker, the owner works on the back and thieves take from the front
+class WorkStealingDeque {
+ public:
+  void Push(Task task) {
+    std::lock_guard lock{mutex_};
+    tasks_.push_back(std::move(task));
+  }
+
+  bool Pop(Task& task) {
+    std::lock_guard lock{mutex_};
+    if (tasks_.empty()) {
+      return false;
+    }
+    task = std::move(tasks_.back());
+    tasks_.pop_back();
+    return true;
+  }
+
+  bool Steal(Task& task) {
+    std::lock_guard lock{mutex_};
+    if (tasks_.empty()) {
+      return false;
+    }
+    task = std::move(tasks_.front());
+    tasks_.pop_front();
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::deque<Task> tasks_;
+};
+
+/// subset -> provisional id, split by the subset hash into independently locked StateSetTables
+class ShardedSubsetTable {
+ public:
+  static constexpr std::size_t kShards = 64;
+
+  explicit ShardedSubsetTable(std::size_t universe) {
+    for (std::size_t i = 0; i != kShards; ++i) {
+      shards_.emplace_back(universe);
+    }
+  }
+
+  /// returns the id of the subset and whether it was inserted now
+  std::pair<std::uint32_t, bool> Insert(const StateSet& subset) {
+    auto& shard = shards_[subset.Hash() % kShards];
+    std::lock_guard lock{shard.mutex};
+    auto [local, inserted] = shard.sets.Intern(subset);
+    if (inserted) {
+      shard.ids.push_back(next_id_.fetch_add(1, std::memory_order_relaxed));
+    }
+    return {shard.ids[local], inserted};
+  }
+
+  std::size_t Size() const { return next_id_.load(); }
+
+  /// the shard tables, called when no worker is running
+  std::size_t MemoryUsage() const {
+    std::size_t bytes = 0;
+    for (const auto& shard : shards_) {
+      bytes += shard.sets.MemoryUsage() + shard.ids.capacity() * sizeof(std::uint32_t);
+    }
+    return bytes;
+  }
+
+ private:
+  struct Shard {
+    explicit Shard(std::size_t universe) : sets{universe} {}
+    std::mutex mutex;
+    StateSetTable sets;
+    std::vector<std::uint32_t> ids;
+  };
+
+  // a deque, the shards are not movable
+  std::deque<Shard> shards_;
+  std::atomic<std::uint32_t> next_id_{0};
+};
+
+struct Edge {
+  std::uint32_t from;
+  std::uint32_t symbol_class;
+  std::uint32_t to;
+};
+
+}  // namespace
+
+NondeterministicFiniteAutomaton NondeterministicFiniteAutomaton::ToDeterministic(std::size_t threads) const {
+  stats::ScopedPhase phase{Phase::kToDeterministic};
+  if (threads == 0) {
+    threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  NondeterministicFiniteAutomaton dfa;
+  if (start_states_.empty()) {
+    return dfa;
+  }
+
+  const CompactNondeterministicAutomaton compact{*this};
+  const AlphabetPartition alphabet{compact};
+  std::vector<std::size_t> columns(alphabet.ClassesCount());
+  for (std::uint32_t symbol_class = 0; symbol_class != columns.size(); ++symbol_class) {
+    columns[symbol_class] = compact.Column(alphabet.Representative(symbol_class));
+  }
+  const auto& start = compact.StartStates();
+
+  ShardedSubsetTable table{compact.StatesCount()};
+  std::vector<WorkStealingDeque> deques(threads);
+  std::vector<std::vector<Edge>> edges(threads);
+  std::vector<std::vector<std::uint32_t>> finals(threads);
+  // subsets found but not processed yet, and tasks waiting in the deques
+  std::atomic<std::size_t> pending{1};
+  std::atomic<std::size_t> queued{1};
+  // idle workers sleep until a task is pushed or the work is done
+  std::mutex idle_mutex;
+  std::condition_variable idle;
+  std::atomic<std::size_t> sleeping{0};
+  auto wake = [&](bool all) {
+    if (sleeping.load() == 0) {
+      return;
+    }
+    // under the mutex, so a worker that is about to sleep sees the change first
+    std::lock_guard lock{idle_mutex};
+    if (all) {
+      idle.notify_all();
+    } else {
+      idle.notify_one();
+    }
+  };
+  {
+    StateSet start_set{compact.StatesCount()};
+    for (auto state : start) {
+      start_set.Insert(state);
+    }
+    deques[0].Push(Task{start, table.Insert(start_set).first});
+  }
+
+  auto work = [&](std::size_t worker) {
+    Task task;
+    StateSet next{compact.StatesCount()};
+    while (true) {
+      bool found = deques[worker].Pop(task);
+      for (std::size_t i = 1; !found && i != threads; ++i) {
+        found = deques[(worker + i) % threads].Steal(task);
+      }
+      if (!found) {
+        std::unique_lock lock{idle_mutex};
+        sleeping.fetch_add(1);
+        idle.wait(lock, [&] { return pending.load() == 0 || queued.load() != 0; });
+        sleeping.fetch_sub(1);
+        if (pending.load() == 0) {
+          return;
+        }
+        continue;
+      }
+      queued.fetch_sub(1);
+      if (std::any_of(task.subset.begin(), task.subset.end(),
+                      [&](std::uint32_t state) { return compact.IsStateFinal(state); })) {
+        finals[worker].push_back(task.id);
+      }
+      for (std::uint32_t symbol_class = 0; symbol_class != columns.size(); ++symbol_class) {
+        const auto column = columns[symbol_class];
+        next.Clear();
+        for (auto from : task.subset) {
+          for (auto it = compact.SuccessorsBegin(from, column), end = compact.SuccessorsEnd(from, column); it != end;
+               ++it) {
+            next.Insert(*it);
+          }
+        }
+        if (next.Empty()) {
+          continue;
+        }
+        auto [to, inserted] = table.Insert(next);
+        edges[worker].push_back(Edge{task.id, symbol_class, to});
+        if (inserted) {
+          Subset subset;
+          subset.reserve(next.Size());
+          next.ForeachState([&](std::uint32_t state) { subset.push_back(state); });
+          pending.fetch_add(1);
+          deques[worker].Push(Task{std::move(subset), to});
+          queued.fetch_add(1);
+          wake(false);
+        }
+      }
+      if (pending.fetch_sub(1) == 1) {
+        wake(true);
+      }
+    }
+  };
+  std::vector<std::thread> workers;
+  for (std::size_t worker = 1; worker < threads; ++worker) {
+    workers.emplace_back(work, worker);
+  }
+  work(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  // deterministic renumbering: breadth-first from the start subset by ascending classes
+  std::vector<std::vector<std::pair<std::uint32_t, std::uint32_t>>> adjacency(table.Size());
+  for (auto& worker_edges : edges) {
+    for (auto& edge : worker_edges) {
+      adjacency[edge.from].emplace_back(edge.symbol_class, edge.to);
+    }
+  }
+  std::vector<bool> final_ids(table.Size(), false);
+  for (auto& worker_finals : finals) {
+    for (auto id : worker_finals) {
+      final_ids[id] = true;
+    }
+  }
+  std::vector<State> renumbered(table.Size(), 0);
+  std::queue<std::uint32_t> to_process;
+  State state = 1;
+  renumbered[0] = state;
+  to_process.push(0);
+  std::vector<State> dfa_finals;
+  while (!to_process.empty()) {
+    auto from = to_process.front();
+    to_process.pop();
+    if (final_ids[from]) {
+      dfa_finals.push_back(renumbered[from]);
+    }
+    auto& out = adjacency[from];
+    std::sort(out.begin(), out.end());
+    for (auto& [symbol_class, to] : out) {
+      if (renumbered[to] == 0) {
+        renumbered[to] = ++state;
+        to_process.push(to);
+      }
+      alphabet.ForeachSymbolOf(symbol_class, [&](Symbol symbol) {
+        dfa.AddTransition(renumbered[from], symbol, renumbered[to]);
+      });
+    }
+  }
+  // the start subset may have no transitions
+  dfa.AddState(1);
+  dfa.SetStartState(1, true);
+  for (auto final_state : dfa_finals) {
+    dfa.AddState(final_state);
+    dfa.SetFinalState(final_state, true);
+  }
+  if constexpr (kStatsEnabled) {
+    stats::RecordBytes(table.MemoryUsage() + dfa.MemoryUsage());
+  }
+  return dfa;
+}
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,106 @@
+#include <cppformlang/finite_automata/pattern_cache.h>
+#include <cppformlang/finite_automata/regex.h>
+
+#include <utility>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+/// the bytes of the tables of an entry, the key included
+std::size_t MemoryOf(const DenseDeterministicAutomaton& dfa, const std::string& key) {
+  return sizeof(DenseDeterministicAutomaton) + key.size() + dfa.MemoryUsage();
+}
+
+}  // namespace
+
+PatternCache::PatternCache(std::size_t capacity) : capacity_{capacity} {}
+
+PatternCache::Automaton PatternCache::Get(const std::string& regex) {
+  std::shared_future<Automaton> found;
+  {
+    // the text is tried as it is first, a regex written canonically is found without parsing it
+    std::lock_guard lock{mutex_};
+    if (auto future = Find(regex); future != nullptr) {
+      ++hits_;
+      found = *future;
+    }
+  }
+  if (found.valid()) {
+    return found.get();
+  }
+
+  auto parsed = Regex::Parse(regex);
+  if (!parsed) {
+    return nullptr;
+  }
+  auto key = parsed->ToString();
+  std::promise<Automaton> promise;
+  std::size_t id = 0;
+  {
+    std::lock_guard lock{mutex_};
+    if (auto future = key != regex ? Find(key) : nullptr; future != nullptr) {
+      ++hits_;
+      found = *future;
+    } else {
+      ++misses_;
+      id = next_id_++;
+      lru_.push_front(Entry{key, id, promise.get_future().share(), 0, false});
+      entries_.emplace(key, lru_.begin());
+    }
+  }
+  if (found.valid()) {
+    return found.get();
+  }
+
+  // the waiters are released before the entry is accounted
+  auto automaton = std::make_shared<const DenseDeterministicAutomaton>(
+      DenseDeterministicAutomaton{parsed->ToPositionAutomaton()}.Minimize());
+  promise.set_value(automaton);
+  std::lock_guard lock{mutex_};
+  // the entry may have been cleared meanwhile and the key taken by another compilation
+  if (auto it = entries_.find(key); it != entries_.end() && it->second->id == id) {
+    it->second->bytes = MemoryOf(*automaton, key);
+    it->second->ready = true;
+    bytes_ += it->second->bytes;
+    Evict();
+  }
+  return automaton;
+}
+
+PatternCache::Stats PatternCache::GetStats() const {
+  std::lock_guard lock{mutex_};
+  return Stats{hits_, misses_, evictions_, entries_.size(), bytes_};
+}
+
+void PatternCache::Clear() {
+  std::lock_guard lock{mutex_};
+  entries_.clear();
+  lru_.clear();
+  bytes_ = 0;
+}
+
+std::shared_future<PatternCache::Automaton>* PatternCache::Find(const std::string& key) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return &it->second->automaton;
+}
+
+void PatternCache::Evict() {
+  // entries in compilation take no bytes yet and are kept, so that their waiters still share them
+  for (auto it = lru_.end(); bytes_ > capacity_ && it != lru_.begin();) {
+    --it;
+    if (!it->ready) {
+      continue;
+    }
+    bytes_ -= it->bytes;
+    ++evictions_;
+    entries_.erase(it->key);
+    it = lru_.erase(it);
+  }
+}
+
+}  // namespace cppformlang::finite_automata
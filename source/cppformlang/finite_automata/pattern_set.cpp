@@ -0,0 +1,139 @@
+#include <cppformlang/finite_automata/alphabet_partition.h>
+#include <cppformlang/finite_automata/compact_nondeterministic_automaton.h>
+#include <cppformlang/finite_automata/minimization.h>
+#include <cppformlang/finite_automata/pattern_set.h>
+#include <cppformlang/finite_automata/regex.h>
+#include <cppformlang/finite_automata/state_set.h>
+#include <utils/hash.h>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+constexpr auto kDead = DenseDeterministicAutomaton::kDeadState;
+constexpr auto kNoPattern = std::numeric_limits<std::uint32_t>::max();
+
+struct HashTags {
+  std::size_t operator()(const std::vector<std::uint32_t>& value) const {
+    return utils::hash_range<std::uint32_t>(value.begin(), value.end());
+  }
+};
+
+}  // namespace
+
+PatternSet::PatternSet() : tag_sets_(1), patterns_count_{0} {}
+
+std::optional<PatternSet> PatternSet::Compile(const std::vector<std::string>& patterns) {
+  // the union, the states of a pattern follow the states of the patterns before it
+  NondeterministicFiniteAutomaton nfa;
+  std::vector<State> offsets;
+  State offset = 0;
+  for (std::uint32_t id = 0; id != patterns.size(); ++id) {
+    auto regex = Regex::Parse(patterns[id]);
+    if (!regex) {
+      return std::nullopt;
+    }
+    auto automaton = regex->ToPositionAutomaton();
+    automaton.ForeachTransition([&](State from, Symbol by, State to) {
+      nfa.AddTransition(offset + from, by, offset + to);
+    });
+    automaton.ForeachStartState([&](State state) { nfa.SetStartState(offset + state, true); });
+    automaton.ForeachFinalState([&](State state) { nfa.SetFinalState(offset + state, true); });
+    offsets.push_back(offset);
+    offset += static_cast<State>(regex->PositionsCount()) + 1;
+  }
+
+  const CompactNondeterministicAutomaton compact{nfa};
+  const AlphabetPartition alphabet{compact};
+  std::vector<std::size_t> columns(alphabet.ClassesCount());
+  for (std::uint32_t symbol_class = 0; symbol_class != columns.size(); ++symbol_class) {
+    columns[symbol_class] = compact.Column(alphabet.Representative(symbol_class));
+  }
+  std::vector<std::uint32_t> final_pattern(compact.StatesCount(), kNoPattern);
+  for (std::uint32_t state = 0; state != compact.StatesCount(); ++state) {
+    if (compact.IsStateFinal(state)) {
+      auto it = std::upper_bound(offsets.begin(), offsets.end(), compact.GetState(state));
+      final_pattern[state] = static_cast<std::uint32_t>(it - offsets.begin()) - 1;
+    }
+  }
+
+  PatternSet set;
+  set.patterns_count_ = patterns.size();
+  std::unordered_map<std::vector<std::uint32_t>, std::uint32_t, HashTags> tag_ids;
+  tag_ids.emplace(std::vector<std::uint32_t>{}, 0);
+
+  // the subset construction of ToDeterministic, every subset is labeled by its tag set
+  StateSetTable subsets{compact.StatesCount()};
+  StateSet next{compact.StatesCount()};
+  for (auto state : compact.StartStates()) {
+    next.Insert(state);
+  }
+  subsets.Intern(next);
+  std::vector<State> table;
+  std::vector<State> labels;
+  std::vector<State> final_states;
+  std::vector<std::uint32_t> current;
+  std::vector<std::uint32_t> tags;
+  for (std::uint32_t from_id = 0; from_id != subsets.Size(); ++from_id) {
+    current.clear();
+    subsets.ForeachState(from_id, [&](std::uint32_t state) { current.push_back(state); });
+    tags.clear();
+    for (auto state : current) {
+      if (final_pattern[state] != kNoPattern) {
+        tags.push_back(final_pattern[state]);
+      }
+    }
+    std::sort(tags.begin(), tags.end());
+    tags.erase(std::unique(tags.begin(), tags.end()), tags.end());
+    auto [it, inserted] = tag_ids.emplace(tags, static_cast<std::uint32_t>(set.tag_sets_.size()));
+    if (inserted) {
+      set.tag_sets_.push_back(tags);
+    }
+    labels.push_back(it->second);
+    if (it->second != 0) {
+      final_states.push_back(from_id);
+    }
+
+    for (auto column : columns) {
+      next.Clear();
+      for (auto from : current) {
+        for (auto to = compact.SuccessorsBegin(from, column), end = compact.SuccessorsEnd(from, column); to != end;
+             ++to) {
+          next.Insert(*to);
+        }
+      }
+      table.push_back(next.Empty() ? kDead : subsets.Intern(next).first);
+    }
+  }
+
+  // states are merged only within a tag set, the label of the dead state is the empty set
+  const DenseDeterministicAutomaton subset_automaton{alphabet, std::move(table), final_states, 0};
+  std::vector<State> state_ids;
+  set.dfa_ = Quotient(subset_automaton, HopcroftPartition(subset_automaton, labels), &state_ids);
+  set.state_tags_.assign(set.dfa_.StatesCount(), 0);
+  for (State state = 0; state != state_ids.size(); ++state) {
+    if (state_ids[state] != kDead) {
+      set.state_tags_[state_ids[state]] = labels[state];
+    }
+  }
+  return set;
+}
+
+const std::vector<std::uint32_t>& PatternSet::Match(const Symbol* begin, const Symbol* end) const {
+  auto state = dfa_.StartState();
+  const auto columns = dfa_.ColumnsCount();
+  for (; begin != end && state != kDead; ++begin) {
+    if (*begin == kEpsilon) {
+      continue;
+    }
+    auto column = dfa_.Column(*begin);
+    state = column == columns ? kDead : dfa_.Next(state, column);
+  }
+  return Tags(state);
+}
+
+}  // namespace cppformlang::finite_automata
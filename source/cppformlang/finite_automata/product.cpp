@@ -0,0 +1,287 @@
+#include <cppformlang/finite_automata/compact_nondeterministic_automaton.h>
+#include <cppformlang/finite_automata/product.h>
+#include <cppformlang/finite_automata/state_set.h>
+#include <utils/hash.h>
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+constexpr auto kNone = std::numeric_limits<std::uint32_t>::max();
+
+/// maps pairs of 32-bit values to ids 0, 1, ... in the order of insertion, with open addressing
+class PairTable {
+ public:
+  PairTable() : slots_(16, kNone) {}
+
+  /// returns the id of the pair and whether it was inserted now
+  std::pair<std::uint32_t, bool> Insert(std::uint32_t first, std::uint32_t second) {
+    if ((keys_.size() + 1) * 2 > slots_.size()) {
+      Grow();
+    }
+    const auto key = std::uint64_t{first} << 32 | second;
+    const auto mask = slots_.size() - 1;
+    for (auto slot = Hash(key) & mask;; slot = (slot + 1) & mask) {
+      if (slots_[slot] == kNone) {
+        slots_[slot] = static_cast<std::uint32_t>(keys_.size());
+        keys_.push_back(key);
+        return {slots_[slot], true};
+      }
+      if (keys_[slots_[slot]] == key) {
+        return {slots_[slot], false};
+      }
+    }
+  }
+
+  std::uint32_t First(std::uint32_t id) const { return static_cast<std::uint32_t>(keys_[id] >> 32); }
+  std::uint32_t Second(std::uint32_t id) const { return static_cast<std::uint32_t>(keys_[id]); }
+  std::size_t Size() const { return keys_.size(); }
+
+ private:
+  static std::size_t Hash(std::uint64_t key) {
+    std::size_t seed = 0;
+    utils::hash_combine(seed, static_cast<std::size_t>(key));
+    utils::hash_combine(seed, static_cast<std::size_t>(key >> 32));
+    return seed;
+  }
+
+  void Grow() {
+    slots_.assign(slots_.size() * 2, kNone);
+    const auto mask = slots_.size() - 1;
+    for (std::uint32_t id = 0; id != keys_.size(); ++id) {
+      auto slot = Hash(keys_[id]) & mask;
+      while (slots_[slot] != kNone) {
+        slot = (slot + 1) & mask;
+      }
+      slots_[slot] = id;
+    }
+  }
+
+  std::vector<std::uint64_t> keys_;
+  std::vector<std::uint32_t> slots_;
+};
+
+/// the column of right for every column of left, kNone if right does not read the symbol
+std::vector<std::uint32_t> MatchColumns(const CompactNondeterministicAutomaton& left,
+                                        const CompactNondeterministicAutomaton& right) {
+  std::vector<std::uint32_t> columns(left.SymbolsCount(), kNone);
+  for (std::size_t column = 0; column != left.SymbolsCount(); ++column) {
+    auto right_column = right.Column(left.GetSymbol(column));
+    if (right_column != right.SymbolsCount()) {
+      columns[column] = static_cast<std::uint32_t>(right_column);
+    }
+  }
+  return columns;
+}
+
+/// states of the product are numbered from 1 by their pair id, the first starts pairs are the start states
+void MarkStates(std::size_t starts, const std::vector<std::uint32_t>& finals,
+                NondeterministicFiniteAutomaton& result) {
+  // a start or final pair may have no transitions
+  for (std::uint32_t id = 0; id != starts; ++id) {
+    result.AddState(id + 1);
+    result.SetStartState(id + 1, true);
+  }
+  for (auto id : finals) {
+    result.AddState(id + 1);
+    result.SetFinalState(id + 1, true);
+  }
+}
+
+/**
+ * explores the reachable pairs of states of two epsilon-free automata, builds the product into result
+ * if it is not nullptr, otherwise stops at the first final pair, returns whether a final pair is reachable
+ */
+bool ExploreIntersection(const CompactNondeterministicAutomaton& left, const CompactNondeterministicAutomaton& right,
+                         NondeterministicFiniteAutomaton* result) {
+  const auto columns = MatchColumns(left, right);
+  PairTable pairs;
+  for (auto p : left.StartStates()) {
+    for (auto q : right.StartStates()) {
+      pairs.Insert(p, q);
+    }
+  }
+  const auto starts = pairs.Size();
+  std::vector<std::uint32_t> finals;
+  for (std::uint32_t id = 0; id != pairs.Size(); ++id) {
+    const auto p = pairs.First(id);
+    const auto q = pairs.Second(id);
+    if (left.IsStateFinal(p) && right.IsStateFinal(q)) {
+      if (result == nullptr) {
+        return true;
+      }
+      finals.push_back(id);
+    }
+    for (std::size_t column = 0; column != columns.size(); ++column) {
+      const auto right_column = columns[column];
+      if (right_column == kNone) {
+        continue;
+      }
+      for (auto left_to = left.SuccessorsBegin(p, column), left_end = left.SuccessorsEnd(p, column);
+           left_to != left_end; ++left_to) {
+        for (auto right_to = right.SuccessorsBegin(q, right_column), right_end = right.SuccessorsEnd(q, right_column);
+             right_to != right_end; ++right_to) {
+          auto to = pairs.Insert(*left_to, *right_to).first;
+          if (result != nullptr) {
+            result->AddTransition(id + 1, left.GetSymbol(column), to + 1);
+          }
+        }
+      }
+    }
+  }
+  if (result != nullptr) {
+    MarkStates(starts, finals, *result);
+  }
+  return !finals.empty();
+}
+
+/**
+ * explores the reachable pairs of a state of left and a subset of right, left == nullptr stands for the
+ * one state automaton of all words over the symbols of right, builds the product into result if it is
+ * not nullptr, otherwise stops at the first final pair, returns whether a final pair is reachable
+ */
+bool ExploreDifference(const CompactNondeterministicAutomaton* left, const CompactNondeterministicAutomaton& right,
+                       NondeterministicFiniteAutomaton* result) {
+  std::vector<std::uint32_t> columns;
+  if (left != nullptr) {
+    columns = MatchColumns(*left, right);
+  } else {
+    for (std::uint32_t column = 0; column != right.SymbolsCount(); ++column) {
+      columns.push_back(column);
+    }
+  }
+  const std::uint32_t universal[] = {0};
+  auto left_begin = [&](std::uint32_t p, std::size_t column) {
+    return left != nullptr ? left->SuccessorsBegin(p, column) : std::begin(universal);
+  };
+  auto left_end = [&](std::uint32_t p, std::size_t column) {
+    return left != nullptr ? left->SuccessorsEnd(p, column) : std::end(universal);
+  };
+  auto symbol = [&](std::size_t column) {
+    return left != nullptr ? left->GetSymbol(column) : right.GetSymbol(column);
+  };
+
+  StateSet set{right.StatesCount()};
+  StateSetTable sets{right.StatesCount()};
+  std::vector<bool> accepting_sets;
+  std::vector<std::uint32_t> set_next;
+  auto intern = [&]() {
+    auto [id, inserted] = sets.Intern(set);
+    if (inserted) {
+      bool accepting = false;
+      set.ForeachState([&](std::uint32_t state) { accepting = accepting || right.IsStateFinal(state); });
+      accepting_sets.push_back(accepting);
+      set_next.resize(set_next.size() + columns.size(), kNone);
+    }
+    return id;
+  };
+  for (auto q : right.StartStates()) {
+    set.Insert(q);
+  }
+  const auto start_set = intern();
+
+  PairTable pairs;
+  if (left != nullptr) {
+    for (auto p : left->StartStates()) {
+      pairs.Insert(p, start_set);
+    }
+  } else {
+    pairs.Insert(0, start_set);
+  }
+  const auto starts = pairs.Size();
+  std::vector<std::uint32_t> finals;
+  for (std::uint32_t id = 0; id != pairs.Size(); ++id) {
+    const auto p = pairs.First(id);
+    const auto s = pairs.Second(id);
+    if ((left == nullptr || left->IsStateFinal(p)) && !accepting_sets[s]) {
+      if (result == nullptr) {
+        return true;
+      }
+      finals.push_back(id);
+    }
+    for (std::size_t column = 0; column != columns.size(); ++column) {
+      auto begin = left_begin(p, column);
+      auto end = left_end(p, column);
+      if (begin == end) {
+        continue;
+      }
+      auto next_set = set_next[s * columns.size() + column];
+      if (next_set == kNone) {
+        set.Clear();
+        if (columns[column] != kNone) {
+          sets.ForeachState(s, [&](std::uint32_t q) {
+            for (auto to = right.SuccessorsBegin(q, columns[column]), to_end = right.SuccessorsEnd(q, columns[column]);
+                 to != to_end; ++to) {
+              set.Insert(*to);
+            }
+          });
+        }
+        next_set = intern();
+        set_next[s * columns.size() + column] = next_set;
+      }
+      for (; begin != end; ++begin) {
+        auto to = pairs.Insert(*begin, next_set).first;
+        if (result != nullptr) {
+          result->AddTransition(id + 1, symbol(column), to + 1);
+        }
+      }
+    }
+  }
+  if (result != nullptr) {
+    MarkStates(starts, finals, *result);
+  }
+  return !finals.empty();
+}
+
+}  // namespace
+
+template <typename Transitions>
+NondeterministicFiniteAutomaton Intersect(const FiniteAutomaton<Transitions>& left,
+                                          const FiniteAutomaton<Transitions>& right) {
+  NondeterministicFiniteAutomaton result;
+  ExploreIntersection(CompactNondeterministicAutomaton{left}, CompactNondeterministicAutomaton{right}, &result);
+  return result;
+}
+
+template <typename Transitions>
+NondeterministicFiniteAutomaton Difference(const FiniteAutomaton<Transitions>& left,
+                                           const FiniteAutomaton<Transitions>& right) {
+  NondeterministicFiniteAutomaton result;
+  const CompactNondeterministicAutomaton compact_left{left};
+  ExploreDifference(&compact_left, CompactNondeterministicAutomaton{right}, &result);
+  return result;
+}
+
+template <typename Transitions>
+NondeterministicFiniteAutomaton Complement(const FiniteAutomaton<Transitions>& automaton) {
+  NondeterministicFiniteAutomaton result;
+  ExploreDifference(nullptr, CompactNondeterministicAutomaton{automaton}, &result);
+  return result;
+}
+
+template <typename Transitions>
+bool IsIntersectionEmpty(const FiniteAutomaton<Transitions>& left, const FiniteAutomaton<Transitions>& right) {
+  return !ExploreIntersection(CompactNondeterministicAutomaton{left}, CompactNondeterministicAutomaton{right}, nullptr);
+}
+
+template <typename Transitions>
+bool IsDifferenceEmpty(const FiniteAutomaton<Transitions>& left, const FiniteAutomaton<Transitions>& right) {
+  const CompactNondeterministicAutomaton compact_left{left};
+  return !ExploreDifference(&compact_left, CompactNondeterministicAutomaton{right}, nullptr);
+}
+
+template NondeterministicFiniteAutomaton Intersect(const FiniteAutomaton<NondeterministicTransitions>&,
+                                                   const FiniteAutomaton<NondeterministicTransitions>&);
+template NondeterministicFiniteAutomaton Difference(const FiniteAutomaton<NondeterministicTransitions>&,
+                                                    const FiniteAutomaton<NondeterministicTransitions>&);
+template NondeterministicFiniteAutomaton Complement(const FiniteAutomaton<NondeterministicTransitions>&);
+template bool IsIntersectionEmpty(const FiniteAutomaton<NondeterministicTransitions>&,
+                                  const FiniteAutomaton<NondeterministicTransitions>&);
+template bool IsDifferenceEmpty(const FiniteAutomaton<NondeterministicTransitions>&,
+                                const FiniteAutomaton<NondeterministicTransitions>&);
+
+}  // namespace cppformlang::finite_automata
@@ -1,4 +1,5 @@
 #include <cppformlang/finite_automata/recursive_automation.h>
+#include <cppformlang/finite_automata/recursive_recognizer.h>
 
 namespace cppformlang::finite_automata {
 
@@ -20,4 +21,10 @@ const NondeterministicFiniteAutomaton* RecursiveAutomaton::GetBox(Symbol label)
 
 void RecursiveAutomaton::SetInitLabel(Symbol label) { init_label_ = label; }
 
+Symbol RecursiveAutomaton::GetInitLabel() const { return init_label_; }
+
+bool RecursiveAutomaton::Accepts(const Symbol* begin, const Symbol* end) const {
+  return RecursiveRecognizer{*this}.Accepts(begin, end);
+}
+
 }  // namespace cppformlang::finite_automata
\ No newline at end of file
@@ -0,0 +1,352 @@
+#include <cppformlang/finite_automata/dense_deterministic_automaton.h>
+#include <cppformlang/finite_automata/recursive_recognizer.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+using Call = RecursiveRecognizer::Call;
+
+constexpr auto kNone = RecursiveRecognizer::kNone;
+constexpr std::size_t kChunkWords = 64;
+
+/// a set of 64-bit keys with open addressing, cleared in the time of its size
+class KeySet {
+ public:
+  KeySet() : slots_(64, kEmpty) {}
+
+  /// returns whether the key was inserted now
+  bool Insert(std::uint64_t key) {
+    if ((used_.size() + 1) * 2 > slots_.size()) {
+      Grow();
+    }
+    const auto mask = slots_.size() - 1;
+    for (auto slot = Hash(key) & mask;; slot = (slot + 1) & mask) {
+      if (slots_[slot] == kEmpty) {
+        slots_[slot] = key;
+        used_.push_back(slot);
+        return true;
+      }
+      if (slots_[slot] == key) {
+        return false;
+      }
+    }
+  }
+
+  void Clear() {
+    for (auto slot : used_) {
+      slots_[slot] = kEmpty;
+    }
+    used_.clear();
+  }
+
+ private:
+  static constexpr auto kEmpty = std::numeric_limits<std::uint64_t>::max();
+
+  static std::size_t Hash(std::uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return static_cast<std::size_t>(key);
+  }
+
+  void Grow() {
+    std::vector<std::uint64_t> keys;
+    keys.reserve(used_.size());
+    for (auto slot : used_) {
+      keys.push_back(slots_[slot]);
+    }
+    slots_.assign(slots_.size() * 2, kEmpty);
+    used_.clear();
+    for (auto key : keys) {
+      Insert(key);
+    }
+  }
+
+  std::vector<std::uint64_t> slots_;
+  std::vector<std::size_t> used_;
+};
+
+/**
+ * the graph-structured stack of one word, kept between the words of a batch so that its buffers are reused,
+ * a node is a box called at a position, its edges lead to the state to return to and the node of the caller,
+ * its pops are the positions the box returned at
+ */
+class Parser {
+ public:
+  explicit Parser(const RecursiveRecognizer& recognizer)
+      : recognizer_{recognizer}, node_stamps_(recognizer.BoxesCount(), kNone), box_nodes_(recognizer.BoxesCount()) {}
+
+  bool Accepts(const Symbol* begin, const Symbol* end) {
+    const auto init = recognizer_.InitBox();
+    if (init == kNone || recognizer_.StartState(init) == kNone) {
+      return false;
+    }
+    word_.clear();
+    for (; begin != end; ++begin) {
+      if (*begin == kEpsilon) {
+        continue;
+      }
+      auto terminal = recognizer_.Terminal(*begin);
+      if (terminal == kNone) {
+        return false;
+      }
+      word_.push_back(terminal);
+    }
+    nodes_.clear();
+    edges_.clear();
+    pops_.clear();
+    std::fill(node_stamps_.begin(), node_stamps_.end(), kNone);
+    if (pending_.size() < word_.size() + 1) {
+      pending_.resize(word_.size() + 1);
+    }
+    for (std::size_t position = 0; position <= word_.size(); ++position) {
+      pending_[position].clear();
+    }
+
+    accepted_ = false;
+    Descend(init, 0);
+    for (std::uint32_t position = 0; position <= word_.size() && !accepted_; ++position) {
+      seen_.Clear();
+      // the bucket grows while it is processed, calls and nullable returns stay at the same position
+      for (std::size_t i = 0; i != pending_[position].size() && !accepted_; ++i) {
+        const auto [state, node] = pending_[position][i];
+        if (seen_.Insert(std::uint64_t{node} << 32 | state)) {
+          Process(state, node, position);
+        }
+      }
+    }
+    return accepted_;
+  }
+
+ private:
+  struct Descriptor {
+    State state;
+    std::uint32_t node;
+  };
+
+  struct Node {
+    std::uint32_t edges;
+    std::uint32_t pops;
+    std::uint32_t last_pop;
+  };
+
+  struct Edge {
+    State to;
+    std::uint32_t caller;
+    std::uint32_t next;
+  };
+
+  struct Pop {
+    std::uint32_t position;
+    std::uint32_t next;
+  };
+
+  /// gives the node of the box called at the position, a new node starts parsing the box
+  std::uint32_t Descend(std::uint32_t box, std::uint32_t position) {
+    if (node_stamps_[box] == position) {
+      return box_nodes_[box];
+    }
+    node_stamps_[box] = position;
+    box_nodes_[box] = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back(Node{kNone, kNone, kNone});
+    pending_[position].push_back(Descriptor{recognizer_.StartState(box), box_nodes_[box]});
+    return box_nodes_[box];
+  }
+
+  void Process(State state, std::uint32_t node, std::uint32_t position) {
+    if (recognizer_.IsStateFinal(state)) {
+      Return(node, position);
+    }
+    const bool at_end = position == word_.size();
+    if (!at_end) {
+      auto to = recognizer_.Next(state, word_[position]);
+      if (to != kNone) {
+        pending_[position + 1].push_back(Descriptor{to, node});
+      }
+    }
+    for (auto call = recognizer_.CallsBegin(state), end = recognizer_.CallsEnd(state); call != end; ++call) {
+      if (!recognizer_.IsNullable(call->box) && (at_end || !recognizer_.CanStart(call->box, word_[position]))) {
+        continue;
+      }
+      auto callee = Descend(call->box, position);
+      edges_.push_back(Edge{call->to, node, nodes_[callee].edges});
+      nodes_[callee].edges = static_cast<std::uint32_t>(edges_.size() - 1);
+      // the memoized returns of the callee continue the new caller
+      for (auto pop = nodes_[callee].pops; pop != kNone; pop = pops_[pop].next) {
+        pending_[pops_[pop].position].push_back(Descriptor{call->to, node});
+      }
+    }
+  }
+
+  void Return(std::uint32_t node, std::uint32_t position) {
+    // positions are processed in order, so a repeated return of the node is the last one
+    if (nodes_[node].last_pop == position) {
+      return;
+    }
+    nodes_[node].last_pop = position;
+    pops_.push_back(Pop{position, nodes_[node].pops});
+    nodes_[node].pops = static_cast<std::uint32_t>(pops_.size() - 1);
+    if (node == 0 && position == word_.size()) {
+      accepted_ = true;
+    }
+    for (auto edge = nodes_[node].edges; edge != kNone; edge = edges_[edge].next) {
+      pending_[position].push_back(Descriptor{edges_[edge].to, edges_[edge].caller});
+    }
+  }
+
+  const RecursiveRecognizer& recognizer_;
+  std::vector<std::uint32_t> word_;
+  std::vector<Node> nodes_;
+  std::vector<Edge> edges_;
+  std::vector<Pop> pops_;
+  std::vector<std::uint32_t> node_stamps_;
+  std::vector<std::uint32_t> box_nodes_;
+  std::vector<std::vector<Descriptor>> pending_;
+  KeySet seen_;
+  bool accepted_ = false;
+};
+
+}  // namespace
+
+RecursiveRecognizer::RecursiveRecognizer(const RecursiveAutomaton& rsm) : first_words_{0}, init_box_{kNone} {
+  std::vector<Symbol> labels;
+  rsm.ForeachBox([&](Symbol label, const NondeterministicFiniteAutomaton&) { labels.push_back(label); });
+  std::sort(labels.begin(), labels.end());
+  auto box_of = [&](Symbol symbol) {
+    auto it = std::lower_bound(labels.begin(), labels.end(), symbol);
+    return it != labels.end() && *it == symbol ? static_cast<std::uint32_t>(it - labels.begin()) : kNone;
+  };
+  init_box_ = box_of(rsm.GetInitLabel());
+
+  std::vector<DenseDeterministicAutomaton> boxes;
+  for (auto label : labels) {
+    boxes.emplace_back(*rsm.GetBox(label));
+    for (std::size_t index = 0; index != boxes.back().SymbolsCount(); ++index) {
+      if (box_of(boxes.back().GetSymbol(index)) == kNone) {
+        terminals_.push_back(boxes.back().GetSymbol(index));
+      }
+    }
+  }
+  std::sort(terminals_.begin(), terminals_.end());
+  terminals_.erase(std::unique(terminals_.begin(), terminals_.end()), terminals_.end());
+
+  std::size_t states = 0;
+  for (auto& box : boxes) {
+    states += box.StatesCount();
+  }
+  next_.assign(states * terminals_.size(), kNone);
+  final_.assign(states, false);
+  calls_offsets_.assign(states + 1, 0);
+  State offset = 0;
+  for (auto& box : boxes) {
+    start_.push_back(box.StartState() == DenseDeterministicAutomaton::kDeadState ? kNone : offset + box.StartState());
+    for (State state = 0; state != box.StatesCount(); ++state) {
+      final_[offset + state] = box.IsStateFinal(state);
+      for (std::size_t index = 0; index != box.SymbolsCount(); ++index) {
+        auto symbol = box.GetSymbol(index);
+        auto to = box.Next(state, box.Alphabet().ClassAt(index));
+        if (to == DenseDeterministicAutomaton::kDeadState) {
+          continue;
+        }
+        if (auto callee = box_of(symbol); callee != kNone) {
+          calls_.push_back(Call{callee, offset + to});
+        } else {
+          next_[(offset + state) * terminals_.size() + Terminal(symbol)] = offset + to;
+        }
+      }
+      calls_offsets_[offset + state + 1] = calls_.size();
+    }
+    offset += static_cast<State>(box.StatesCount());
+  }
+
+  // nullable boxes and first sets grow together until a fixpoint, a box passes through its nullable callees
+  first_words_ = (terminals_.size() + 63) / 64;
+  nullable_.assign(labels.size(), false);
+  first_.assign(labels.size() * first_words_, 0);
+  std::vector<bool> visited(states, false);
+  std::vector<State> stack;
+  std::vector<State> reached;
+  std::vector<std::uint64_t> first(first_words_);
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (std::uint32_t box = 0; box != labels.size(); ++box) {
+      if (start_[box] == kNone) {
+        continue;
+      }
+      bool nullable = false;
+      std::fill(first.begin(), first.end(), 0);
+      stack.assign(1, start_[box]);
+      reached.assign(1, start_[box]);
+      visited[start_[box]] = true;
+      while (!stack.empty()) {
+        auto state = stack.back();
+        stack.pop_back();
+        nullable = nullable || final_[state];
+        for (std::uint32_t terminal = 0; terminal != terminals_.size(); ++terminal) {
+          if (Next(state, terminal) != kNone) {
+            first[terminal / 64] |= std::uint64_t{1} << (terminal % 64);
+          }
+        }
+        for (auto call = CallsBegin(state), end = CallsEnd(state); call != end; ++call) {
+          for (std::size_t word = 0; word != first_words_; ++word) {
+            first[word] |= first_[call->box * first_words_ + word];
+          }
+          if (nullable_[call->box] && !visited[call->to]) {
+            visited[call->to] = true;
+            reached.push_back(call->to);
+            stack.push_back(call->to);
+          }
+        }
+      }
+      for (auto state : reached) {
+        visited[state] = false;
+      }
+      auto old_first = first_.begin() + static_cast<std::ptrdiff_t>(box * first_words_);
+      if (nullable != nullable_[box] || !std::equal(first.begin(), first.end(), old_first)) {
+        nullable_[box] = nullable;
+        std::copy(first.begin(), first.end(), old_first);
+        changed = true;
+      }
+    }
+  }
+}
+
+bool RecursiveRecognizer::Accepts(const Symbol* begin, const Symbol* end) const {
+  return Parser{*this}.Accepts(begin, end);
+}
+
+std::uint32_t RecursiveRecognizer::Terminal(Symbol symbol) const {
+  auto it = std::lower_bound(terminals_.begin(), terminals_.end(), symbol);
+  if (it == terminals_.end() || *it != symbol) {
+    return kNone;
+  }
+  return static_cast<std::uint32_t>(it - terminals_.begin());
+}
+
+void AcceptsBatch(const RecursiveRecognizer& recognizer, const WordBatch& batch, std::uint64_t* result,
+                  utils::ThreadPool* pool) {
+  auto run = [&](std::size_t begin, std::size_t end) {
+    Parser parser{recognizer};
+    for (auto word = begin; word < end; word += 64) {
+      std::uint64_t bits = 0;
+      for (auto i = word, last = std::min(word + 64, end); i != last; ++i) {
+        auto accepted = parser.Accepts(batch.symbols + batch.offsets[i], batch.symbols + batch.offsets[i + 1]);
+        bits |= std::uint64_t{accepted} << (i - word);
+      }
+      result[word / 64] = bits;
+    }
+  };
+  if (pool == nullptr || pool->ThreadsCount() == 1) {
+    run(0, batch.words_count);
+    return;
+  }
+  pool->ParallelFor(batch.words_count, kChunkWords, [&](std::size_t begin, std::size_t end, std::size_t) {
+    run(begin, end);
+  });
+}
+
+}  // namespace cppformlang::finite_automata
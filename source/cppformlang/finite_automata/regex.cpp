@@ -0,0 +1,246 @@
+#include <cppformlang/finite_automata/regex.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+using Kind = Regex::Kind;
+
+bool IsOperator(char c) { return c == '\\' || c == '(' || c == ')' || c == '*' || c == '+' || c == '|'; }
+
+int Precedence(char op) { return op == '+' ? 2 : op == '|' ? 1 : 0; }
+
+}  // namespace
+
+Regex::Regex() : positions_count_{0} {}
+
+std::optional<Regex> Regex::Parse(const std::string& regex) {
+  Regex result;
+  auto& nodes = result.nodes_;
+  std::vector<std::uint32_t> operands;
+  std::vector<char> operators;
+  auto reduce = [&]() {
+    const auto right = operands.back();
+    operands.pop_back();
+    const auto kind = operators.back() == '+' ? Kind::kConcatenation : Kind::kUnion;
+    operators.pop_back();
+    nodes.push_back(Node{kind, 0, operands.back(), right, 0});
+    operands.back() = static_cast<std::uint32_t>(nodes.size() - 1);
+  };
+  auto push_operator = [&](char op) {
+    while (!operators.empty() && Precedence(operators.back()) >= Precedence(op)) {
+      reduce();
+    }
+    operators.push_back(op);
+  };
+
+  // an operand is expected at the start, after '(' and after a binary operator
+  bool expect_operand = true;
+  for (std::size_t i = 0; i != regex.size(); ++i) {
+    auto c = regex[i];
+    if (c == '\\' || !IsOperator(c)) {
+      if (c == '\\') {
+        if (++i == regex.size()) {
+          return std::nullopt;
+        }
+        c = regex[i];
+      }
+      if (!expect_operand) {
+        push_operator('+');
+      }
+      nodes.push_back(Node{Kind::kSymbol, c, 0, 0, static_cast<std::uint32_t>(++result.positions_count_)});
+      operands.push_back(static_cast<std::uint32_t>(nodes.size() - 1));
+      expect_operand = false;
+      continue;
+    }
+    switch (c) {
+      case '(': {
+        if (!expect_operand) {
+          push_operator('+');
+        }
+        operators.push_back('(');
+        expect_operand = true;
+      } break;
+      case ')': {
+        if (expect_operand) {
+          return std::nullopt;
+        }
+        while (!operators.empty() && operators.back() != '(') {
+          reduce();
+        }
+        if (operators.empty()) {
+          return std::nullopt;
+        }
+        operators.pop_back();
+      } break;
+      case '*': {
+        if (expect_operand) {
+          return std::nullopt;
+        }
+        nodes.push_back(Node{Kind::kStar, 0, operands.back(), 0, 0});
+        operands.back() = static_cast<std::uint32_t>(nodes.size() - 1);
+      } break;
+      default: {
+        if (expect_operand) {
+          return std::nullopt;
+        }
+        push_operator(c);
+        expect_operand = true;
+      } break;
+    }
+  }
+  if (nodes.empty() && operators.empty()) {
+    nodes.push_back(Node{Kind::kEmpty, 0, 0, 0, 0});
+    return result;
+  }
+  if (expect_operand) {
+    return std::nullopt;
+  }
+  while (!operators.empty()) {
+    if (operators.back() == '(') {
+      return std::nullopt;
+    }
+    reduce();
+  }
+  return result;
+}
+
+std::string Regex::ToString() const {
+  // the stack holds nodes to print, or characters to append when the node is kNone
+  constexpr auto kNone = static_cast<std::uint32_t>(-1);
+  struct Item {
+    std::uint32_t node;
+    char text;
+  };
+  std::string result;
+  std::vector<Item> stack{{Root(), 0}};
+  auto push = [&](std::uint32_t node, bool wrap) {
+    if (wrap) {
+      stack.push_back({kNone, ')'});
+      stack.push_back({node, 0});
+      stack.push_back({kNone, '('});
+    } else {
+      stack.push_back({node, 0});
+    }
+  };
+  auto is = [&](std::uint32_t node, Kind kind) { return nodes_[node].kind == kind; };
+  while (!stack.empty()) {
+    auto [id, text] = stack.back();
+    stack.pop_back();
+    if (id == kNone) {
+      result.push_back(text);
+      continue;
+    }
+    const auto& node = nodes_[id];
+    switch (node.kind) {
+      case Kind::kEmpty:
+        break;
+      case Kind::kSymbol: {
+        auto c = static_cast<char>(node.symbol);
+        if (IsOperator(c)) {
+          result.push_back('\\');
+        }
+        result.push_back(c);
+      } break;
+      case Kind::kStar: {
+        stack.push_back({kNone, '*'});
+        push(node.left, is(node.left, Kind::kUnion) || is(node.left, Kind::kConcatenation));
+      } break;
+      case Kind::kUnion: {
+        push(node.right, is(node.right, Kind::kUnion));
+        stack.push_back({kNone, '|'});
+        push(node.left, false);
+      } break;
+      case Kind::kConcatenation: {
+        push(node.right, is(node.right, Kind::kUnion) || is(node.right, Kind::kConcatenation));
+        stack.push_back({kNone, '+'});
+        push(node.left, is(node.left, Kind::kUnion));
+      } break;
+    }
+  }
+  return result;
+}
+
+NondeterministicFiniteAutomaton Regex::ToPositionAutomaton() const {
+  // the positions of different subtrees are disjoint, so the sets of a node are joined by appending
+  std::vector<bool> nullable(nodes_.size());
+  std::vector<std::vector<std::uint32_t>> first(nodes_.size());
+  std::vector<std::vector<std::uint32_t>> last(nodes_.size());
+  std::vector<Symbol> symbols(positions_count_ + 1);
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> follow;
+  auto join = [](std::vector<std::uint32_t>& to, std::vector<std::uint32_t>& from) {
+    to.insert(to.end(), from.begin(), from.end());
+    from.clear();
+    from.shrink_to_fit();
+  };
+  auto connect = [&](const std::vector<std::uint32_t>& from, const std::vector<std::uint32_t>& to) {
+    for (auto x : from) {
+      for (auto y : to) {
+        follow.emplace_back(x, y);
+      }
+    }
+  };
+  for (std::uint32_t id = 0; id != nodes_.size(); ++id) {
+    const auto& node = nodes_[id];
+    switch (node.kind) {
+      case Kind::kEmpty:
+        break;
+      case Kind::kSymbol: {
+        symbols[node.position] = node.symbol;
+        first[id].push_back(node.position);
+        last[id].push_back(node.position);
+      } break;
+      case Kind::kStar: {
+        connect(last[node.left], first[node.left]);
+        nullable[id] = true;
+        first[id] = std::move(first[node.left]);
+        last[id] = std::move(last[node.left]);
+      } break;
+      case Kind::kUnion: {
+        nullable[id] = nullable[node.left] || nullable[node.right];
+        first[id] = std::move(first[node.left]);
+        join(first[id], first[node.right]);
+        last[id] = std::move(last[node.left]);
+        join(last[id], last[node.right]);
+      } break;
+      case Kind::kConcatenation: {
+        connect(last[node.left], first[node.right]);
+        nullable[id] = nullable[node.left] && nullable[node.right];
+        first[id] = std::move(first[node.left]);
+        if (nullable[node.left]) {
+          join(first[id], first[node.right]);
+        }
+        last[id] = std::move(last[node.right]);
+        if (nullable[node.right]) {
+          join(last[id], last[node.left]);
+        }
+      } break;
+    }
+  }
+
+  NondeterministicFiniteAutomaton result;
+  const auto root = Root();
+  for (auto y : first[root]) {
+    result.AddTransition(0, symbols[y], y);
+  }
+  // nested stars connect the same pair more than once
+  std::sort(follow.begin(), follow.end());
+  follow.erase(std::unique(follow.begin(), follow.end()), follow.end());
+  for (auto [x, y] : follow) {
+    result.AddTransition(x, symbols[y], y);
+  }
+  if (first[root].empty()) {
+    return result;
+  }
+  result.SetStartState(0, true);
+  result.SetFinalState(0, nullable[root]);
+  for (auto x : last[root]) {
+    result.SetFinalState(x, true);
+  }
+  return result;
+}
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,156 @@
+#include <cppformlang/finite_automata/regular_path_query.h>
+#include <utils/bits.h>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <numeric>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+constexpr auto kNoColumn = std::numeric_limits<std::uint32_t>::max();
+
+/// the search state of one thread, reset after every group of sources
+class ProductSearch {
+ public:
+  ProductSearch(const LabeledGraph& graph, const CompactNondeterministicAutomaton& query,
+                const std::vector<std::uint32_t>& columns)
+      : graph_{graph},
+        query_{query},
+        columns_{columns},
+        states_{query.StatesCount()},
+        visited_(graph.VerticesCount() * states_, 0),
+        pending_(graph.VerticesCount() * states_, 0),
+        reached_(graph.VerticesCount(), 0) {}
+
+  /// runs the search from at most 64 sources and appends the reached pairs
+  void Run(const State* sources, std::size_t count, std::vector<std::pair<State, State>>& result) {
+    for (std::size_t i = 0; i != count; ++i) {
+      for (auto state : query_.StartStates()) {
+        Reach(sources[i] * states_ + state, std::uint64_t{1} << i);
+      }
+    }
+    for (std::size_t head = 0; head != queue_.size(); ++head) {
+      const auto index = queue_[head];
+      const auto bits = std::exchange(pending_[index], 0);
+      const auto vertex = static_cast<State>(index / states_);
+      const auto state = static_cast<std::uint32_t>(index % states_);
+      graph_.ForeachRun(vertex, [&](std::uint32_t column, const State* begin, const State* end) {
+        auto query_column = columns_[column];
+        if (query_column == kNoColumn) {
+          return;
+        }
+        for (auto to = query_.SuccessorsBegin(state, query_column), last = query_.SuccessorsEnd(state, query_column);
+             to != last; ++to) {
+          for (auto target = begin; target != end; ++target) {
+            Reach(*target * states_ + *to, bits);
+          }
+        }
+      });
+    }
+    for (auto index : touched_) {
+      if (query_.IsStateFinal(static_cast<std::uint32_t>(index % states_))) {
+        auto vertex = index / states_;
+        if (reached_[vertex] == 0) {
+          reached_vertices_.push_back(static_cast<State>(vertex));
+        }
+        reached_[vertex] |= visited_[index];
+      }
+      visited_[index] = 0;
+    }
+    for (auto vertex : reached_vertices_) {
+      utils::foreach_bit(std::exchange(reached_[vertex], 0), [&](unsigned bit) {
+        result.emplace_back(sources[bit], vertex);
+      });
+    }
+    queue_.clear();
+    touched_.clear();
+    reached_vertices_.clear();
+  }
+
+ private:
+  void Reach(std::size_t index, std::uint64_t bits) {
+    bits &= ~visited_[index];
+    if (bits == 0) {
+      return;
+    }
+    if (visited_[index] == 0) {
+      touched_.push_back(index);
+    }
+    visited_[index] |= bits;
+    if (pending_[index] == 0) {
+      queue_.push_back(index);
+    }
+    pending_[index] |= bits;
+  }
+
+  const LabeledGraph& graph_;
+  const CompactNondeterministicAutomaton& query_;
+  const std::vector<std::uint32_t>& columns_;
+  std::size_t states_;
+  std::vector<std::uint64_t> visited_;
+  std::vector<std::uint64_t> pending_;
+  std::vector<std::uint64_t> reached_;
+  std::vector<std::size_t> queue_;
+  std::vector<std::size_t> touched_;
+  std::vector<State> reached_vertices_;
+};
+
+}  // namespace
+
+std::vector<std::pair<State, State>> RegularPathQuery(const LabeledGraph& graph,
+                                                     const CompactNondeterministicAutomaton& query,
+                                                     const std::vector<State>& sources, utils::ThreadPool* pool) {
+  std::vector<std::pair<State, State>> result;
+  if (query.StatesCount() == 0 || sources.empty()) {
+    return result;
+  }
+  assert(std::all_of(sources.begin(), sources.end(), [&](State source) { return source < graph.VerticesCount(); }));
+  // the query column of every label of the graph
+  std::vector<std::uint32_t> columns(graph.LabelsCount(), kNoColumn);
+  for (std::size_t column = 0; column != graph.LabelsCount(); ++column) {
+    auto query_column = query.Column(graph.GetLabel(column));
+    if (query_column != query.SymbolsCount()) {
+      columns[column] = static_cast<std::uint32_t>(query_column);
+    }
+  }
+
+  if (pool == nullptr || pool->ThreadsCount() == 1) {
+    ProductSearch search{graph, query, columns};
+    for (std::size_t begin = 0; begin < sources.size(); begin += 64) {
+      search.Run(sources.data() + begin, std::min<std::size_t>(64, sources.size() - begin), result);
+    }
+  } else {
+    // the searches are created lazily, a thread that gets no group allocates nothing
+    std::vector<std::unique_ptr<ProductSearch>> searches(pool->ThreadsCount());
+    std::vector<std::vector<std::pair<State, State>>> results(pool->ThreadsCount());
+    pool->ParallelFor((sources.size() + 63) / 64, 1, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+      if (searches[worker] == nullptr) {
+        searches[worker] = std::make_unique<ProductSearch>(graph, query, columns);
+      }
+      for (auto group = begin; group != end; ++group) {
+        searches[worker]->Run(sources.data() + group * 64, std::min<std::size_t>(64, sources.size() - group * 64),
+                              results[worker]);
+      }
+    });
+    for (auto& worker_result : results) {
+      result.insert(result.end(), worker_result.begin(), worker_result.end());
+    }
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+std::vector<std::pair<State, State>> RegularPathQuery(const LabeledGraph& graph,
+                                                     const CompactNondeterministicAutomaton& query,
+                                                     utils::ThreadPool* pool) {
+  std::vector<State> sources(graph.VerticesCount());
+  std::iota(sources.begin(), sources.end(), State{0});
+  return RegularPathQuery(graph, query, sources, pool);
+}
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,245 @@
+#include <cppformlang/finite_automata/search.h>
+#include <utils/bits.h>
+
+#include <cassert>
+#include <cstdint>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+constexpr auto kDead = DenseDeterministicAutomaton::kDeadState;
+
+/// what every word of the language of a node starts with, ends with and contains
+struct Literals {
+  bool exact;  // the language is the single word prefix
+  std::string prefix;
+  std::string suffix;
+  std::string must;
+};
+
+const std::string& Longer(const std::string& left, const std::string& right) {
+  return right.size() > left.size() ? right : left;
+}
+
+Literals Concatenate(const Literals& left, const Literals& right) {
+  Literals result;
+  result.exact = left.exact && right.exact;
+  result.prefix = left.exact ? left.prefix + right.prefix : left.prefix;
+  result.suffix = right.exact ? left.suffix + right.suffix : right.suffix;
+  result.must = Longer(Longer(left.must, right.must), left.suffix + right.prefix);
+  return result;
+}
+
+Literals Unite(const Literals& left, const Literals& right) {
+  Literals result;
+  result.exact = left.exact && right.exact && left.prefix == right.prefix;
+  std::size_t prefix = 0;
+  while (prefix != left.prefix.size() && prefix != right.prefix.size() && left.prefix[prefix] == right.prefix[prefix]) {
+    ++prefix;
+  }
+  result.prefix = left.prefix.substr(0, prefix);
+  std::size_t suffix = 0;
+  while (suffix != left.suffix.size() && suffix != right.suffix.size() &&
+         left.suffix[left.suffix.size() - suffix - 1] == right.suffix[right.suffix.size() - suffix - 1]) {
+    ++suffix;
+  }
+  result.suffix = left.suffix.substr(left.suffix.size() - suffix);
+  result.must = left.must == right.must ? left.must : Longer(result.prefix, result.suffix);
+  return result;
+}
+
+/// the literals of the root, computed bottom up as the children come before their parents
+Literals ExtractLiterals(const Regex& regex) {
+  std::vector<Literals> literals(regex.NodesCount());
+  for (std::uint32_t id = 0; id != regex.NodesCount(); ++id) {
+    auto& node = regex.GetNode(id);
+    switch (node.kind) {
+      case Regex::Kind::kEmpty:
+        literals[id] = {true, {}, {}, {}};
+        break;
+      case Regex::Kind::kSymbol: {
+        std::string symbol(1, static_cast<char>(node.symbol));
+        literals[id] = {true, symbol, symbol, symbol};
+        break;
+      }
+      case Regex::Kind::kUnion:
+        literals[id] = Unite(literals[node.left], literals[node.right]);
+        break;
+      case Regex::Kind::kConcatenation:
+        literals[id] = Concatenate(literals[node.left], literals[node.right]);
+        break;
+      case Regex::Kind::kStar:
+        literals[id] = {false, {}, {}, {}};
+        break;
+    }
+  }
+  return literals.back();
+}
+
+/// the state of one search over a text, the match starts are marked on the first need
+class MatchFinder {
+ public:
+  MatchFinder(const Searcher& searcher, std::string_view text)
+      : forward_{searcher.Forward()},
+        reverse_{searcher.Reverse()},
+        literal_{searcher.RequiredLiteral()},
+        literal_is_prefix_{searcher.IsLiteralPrefix()},
+        text_{text},
+        marked_{false},
+        scanned_{0} {}
+
+  std::optional<Match> Next(std::size_t from) {
+    if (from > text_.size() || forward_.StartState() == kDead) {
+      return std::nullopt;
+    }
+    if (!marked_ && !literal_.empty()) {
+      auto at = text_.find(literal_, from);
+      if (at == std::string_view::npos) {
+        return std::nullopt;
+      }
+      // the forward runs from the occurrences may cost more than a backward scan, then the scan takes over
+      for (; literal_is_prefix_ && at != std::string_view::npos && scanned_ <= text_.size();
+           at = text_.find(literal_, at + 1)) {
+        if (auto end = LongestEnd(at)) {
+          return Match{at, *end};
+        }
+      }
+      if (at == std::string_view::npos) {
+        return std::nullopt;
+      }
+    }
+    if (!marked_) {
+      MarkStarts(from);
+    }
+    auto begin = NextStart(from);
+    if (!begin) {
+      return std::nullopt;
+    }
+    auto end = LongestEnd(*begin);
+    assert(end.has_value());
+    return Match{*begin, *end};
+  }
+
+ private:
+  static Symbol SymbolOf(char byte) { return static_cast<Symbol>(byte); }
+
+  /// the end of the longest match from begin, the forward automaton runs until it dies
+  std::optional<std::size_t> LongestEnd(std::size_t begin) {
+    auto state = forward_.StartState();
+    std::optional<std::size_t> end;
+    if (forward_.IsStateFinal(state)) {
+      end = begin;
+    }
+    const auto columns = forward_.ColumnsCount();
+    auto position = begin;
+    while (position != text_.size()) {
+      auto column = forward_.Column(SymbolOf(text_[position]));
+      state = column == columns ? kDead : forward_.Next(state, column);
+      if (state == kDead) {
+        break;
+      }
+      ++position;
+      if (forward_.IsStateFinal(state)) {
+        end = position;
+      }
+    }
+    scanned_ += position - begin + 1;
+    return end;
+  }
+
+  /// the backward scan of any* rev(R) over [from, size], it accepts where a match starts
+  void MarkStarts(std::size_t from) {
+    marked_ = true;
+    starts_.assign(text_.size() / 64 + 1, 0);
+    auto mark = [&](std::size_t position) { starts_[position / 64] |= std::uint64_t{1} << (position % 64); };
+    const auto start = reverse_.StartState();
+    const auto columns = reverse_.ColumnsCount();
+    auto state = start;
+    if (reverse_.IsStateFinal(state)) {
+      mark(text_.size());
+    }
+    for (auto position = text_.size(); position-- > from;) {
+      // no match crosses a byte out of the alphabet, the any* loop alone survives it
+      auto column = reverse_.Column(SymbolOf(text_[position]));
+      state = column == columns ? start : reverse_.Next(state, column);
+      assert(state != kDead);
+      if (reverse_.IsStateFinal(state)) {
+        mark(position);
+      }
+    }
+  }
+
+  std::optional<std::size_t> NextStart(std::size_t from) const {
+    auto word = from / 64;
+    auto bits = starts_[word] & (~std::uint64_t{0} << (from % 64));
+    while (bits == 0) {
+      if (++word == starts_.size()) {
+        return std::nullopt;
+      }
+      bits = starts_[word];
+    }
+    return word * 64 + utils::count_trailing_zeros(bits);
+  }
+
+  const DenseDeterministicAutomaton& forward_;
+  const DenseDeterministicAutomaton& reverse_;
+  const std::string& literal_;
+  bool literal_is_prefix_;
+  std::string_view text_;
+  bool marked_;
+  std::vector<std::uint64_t> starts_;
+  std::size_t scanned_;
+};
+
+}  // namespace
+
+Searcher::Searcher(const Regex& regex) {
+  auto positions = regex.ToPositionAutomaton();
+  forward_ = DenseDeterministicAutomaton{positions}.Minimize();
+  if (forward_.StartState() == kDead) {
+    return;
+  }
+
+  // a new state loops on the alphabet before the reversed automaton starts
+  auto reversed = positions.Reverse();
+  const auto loop = static_cast<State>(regex.PositionsCount()) + 1;
+  positions.ForeachSymbol([&](Symbol symbol) { reversed.AddTransition(loop, symbol, loop); });
+  std::vector<State> starts;
+  reversed.ForeachStartState([&](State state) { starts.push_back(state); });
+  for (auto state : starts) {
+    reversed.AddTransition(loop, kEpsilon, state);
+    reversed.SetStartState(state, false);
+  }
+  reversed.SetStartState(loop, true);
+  reverse_ = DenseDeterministicAutomaton{reversed}.Minimize();
+
+  auto literals = ExtractLiterals(regex);
+  literal_is_prefix_ = !literals.prefix.empty() && literals.prefix.size() >= literals.must.size();
+  literal_ = literal_is_prefix_ ? literals.prefix : literals.must;
+}
+
+std::optional<Searcher> Searcher::Compile(const std::string& regex) {
+  auto parsed = Regex::Parse(regex);
+  if (!parsed) {
+    return std::nullopt;
+  }
+  return Searcher{*parsed};
+}
+
+std::optional<Match> Searcher::Search(std::string_view text, std::size_t from) const {
+  return MatchFinder{*this, text}.Next(from);
+}
+
+std::vector<Match> Searcher::FindAll(std::string_view text) const {
+  MatchFinder finder{*this, text};
+  std::vector<Match> matches;
+  std::size_t from = 0;
+  while (auto match = finder.Next(from)) {
+    matches.push_back(*match);
+    from = match->end == match->begin ? match->end + 1 : match->end;
+  }
+  return matches;
+}
+
+}  // namespace cppformlang::finite_automata
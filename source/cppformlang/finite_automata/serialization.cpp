@@ -0,0 +1,377 @@
+#include <cppformlang/finite_automata/serialization.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <tuple>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CPPFORMLANG_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define CPPFORMLANG_HAS_MMAP 0
+#endif
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+using Kind = BinaryFormat::Kind;
+
+bool IsLittleEndian() {
+  const std::uint32_t word = 1;
+  unsigned char byte = 0;
+  std::memcpy(&byte, &word, 1);
+  return byte == 1;
+}
+
+/// writes words as little-endian bytes through a fixed buffer
+class WordWriter {
+ public:
+  explicit WordWriter(std::ostream& out) : out_{out}, size_{0} {}
+
+  ~WordWriter() { Flush(); }
+
+  void Put(std::uint32_t word) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    for (int byte = 0; byte != 4; ++byte) {
+      buffer_[size_++] = static_cast<char>((word >> (8 * byte)) & 0xFF);
+    }
+  }
+
+  void Flush() {
+    out_.write(buffer_.data(), static_cast<std::streamsize>(size_));
+    size_ = 0;
+  }
+
+ private:
+  std::ostream& out_;
+  std::array<char, 4096> buffer_;
+  std::size_t size_;
+};
+
+bool ReadWords(std::istream& in, std::uint32_t* words, std::size_t count) {
+  std::array<unsigned char, 4096> buffer;
+  while (count != 0) {
+    auto chunk = std::min(count, buffer.size() / 4);
+    if (!in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(chunk * 4))) {
+      return false;
+    }
+    for (std::size_t i = 0; i != chunk; ++i) {
+      words[i] = std::uint32_t{buffer[4 * i]} | std::uint32_t{buffer[4 * i + 1]} << 8 |
+                 std::uint32_t{buffer[4 * i + 2]} << 16 | std::uint32_t{buffer[4 * i + 3]} << 24;
+    }
+    words += chunk;
+    count -= chunk;
+  }
+  return true;
+}
+
+bool ReadHeader(std::istream& in, Kind kind) {
+  std::uint32_t header[3];
+  return ReadWords(in, header, 3) && header[0] == BinaryFormat::kMagic && header[1] == BinaryFormat::kVersion &&
+         header[2] == static_cast<std::uint32_t>(kind);
+}
+
+void PutHeader(WordWriter& writer, Kind kind) {
+  writer.Put(BinaryFormat::kMagic);
+  writer.Put(BinaryFormat::kVersion);
+  writer.Put(static_cast<std::uint32_t>(kind));
+}
+
+/// the number of words of a dense automaton or 0 if the sizes do not fit in memory
+std::size_t DenseWordsCount(std::uint64_t states, std::uint64_t symbols) {
+  auto words = BinaryFormat::kDenseHeaderWords + symbols + (states + 31) / 32;
+  if (symbols != 0 && states > (~std::uint64_t{0} - words) / symbols) {
+    return 0;
+  }
+  words += states * symbols;
+  if (words > static_cast<std::uint64_t>(~std::size_t{0}) / 4) {
+    return 0;
+  }
+  return static_cast<std::size_t>(words);
+}
+
+}  // namespace
+
+bool Save(const NondeterministicFiniteAutomaton& nfa, std::ostream& out) {
+  std::vector<std::tuple<State, Symbol, State>> transitions;
+  nfa.ForeachTransition([&](State from, Symbol by, State to) { transitions.emplace_back(from, by, to); });
+  std::sort(transitions.begin(), transitions.end());
+  std::vector<State> start_states;
+  nfa.ForeachStartState([&](State state) { start_states.push_back(state); });
+  std::sort(start_states.begin(), start_states.end());
+  std::vector<State> final_states;
+  nfa.ForeachFinalState([&](State state) { final_states.push_back(state); });
+  std::sort(final_states.begin(), final_states.end());
+
+  {
+    WordWriter writer{out};
+    PutHeader(writer, Kind::kNondeterministic);
+    writer.Put(static_cast<std::uint32_t>(transitions.size()));
+    writer.Put(static_cast<std::uint32_t>(start_states.size()));
+    writer.Put(static_cast<std::uint32_t>(final_states.size()));
+    for (auto& [from, by, to] : transitions) {
+      writer.Put(from);
+      writer.Put(static_cast<std::uint32_t>(by));
+      writer.Put(to);
+    }
+    for (auto state : start_states) {
+      writer.Put(state);
+    }
+    for (auto state : final_states) {
+      writer.Put(state);
+    }
+  }
+  return out.good();
+}
+
+bool Save(const DenseDeterministicAutomaton& dfa, std::ostream& out) {
+  const auto states = dfa.StatesCount();
+  const auto symbols = dfa.SymbolsCount();
+  {
+    WordWriter writer{out};
+    PutHeader(writer, Kind::kDenseDeterministic);
+    writer.Put(static_cast<std::uint32_t>(states));
+    writer.Put(static_cast<std::uint32_t>(symbols));
+    writer.Put(dfa.StartState());
+    // the format keeps a column per symbol, the classes are merged again when it is loaded
+    for (std::size_t index = 0; index != symbols; ++index) {
+      writer.Put(static_cast<std::uint32_t>(dfa.GetSymbol(index)));
+    }
+    for (State state = 0; state != states; ++state) {
+      for (std::size_t index = 0; index != symbols; ++index) {
+        writer.Put(dfa.Next(state, dfa.Alphabet().ClassAt(index)));
+      }
+    }
+    for (std::size_t word = 0; word != (states + 31) / 32; ++word) {
+      std::uint32_t bits = 0;
+      for (std::size_t state = word * 32; state != std::min(states, word * 32 + 32); ++state) {
+        bits |= static_cast<std::uint32_t>(dfa.IsStateFinal(static_cast<State>(state))) << (state % 32);
+      }
+      writer.Put(bits);
+    }
+  }
+  return out.good();
+}
+
+std::optional<NondeterministicFiniteAutomaton> LoadNondeterministic(std::istream& in) {
+  std::uint32_t counts[3];
+  if (!ReadHeader(in, Kind::kNondeterministic) || !ReadWords(in, counts, 3)) {
+    return std::nullopt;
+  }
+  NondeterministicFiniteAutomaton nfa;
+  std::uint32_t transition[3];
+  for (std::uint32_t i = 0; i != counts[0]; ++i) {
+    if (!ReadWords(in, transition, 3)) {
+      return std::nullopt;
+    }
+    nfa.AddTransition(transition[0], static_cast<Symbol>(transition[1]), transition[2]);
+  }
+  // the format keeps no states apart from the transitions, a start or final state may have none
+  std::uint32_t state = 0;
+  for (std::uint32_t i = 0; i != counts[1]; ++i) {
+    if (!ReadWords(in, &state, 1)) {
+      return std::nullopt;
+    }
+    nfa.AddState(state);
+    nfa.SetStartState(state, true);
+  }
+  for (std::uint32_t i = 0; i != counts[2]; ++i) {
+    if (!ReadWords(in, &state, 1)) {
+      return std::nullopt;
+    }
+    nfa.AddState(state);
+    nfa.SetFinalState(state, true);
+  }
+  return nfa;
+}
+
+std::optional<DenseDeterministicAutomaton> LoadDenseDeterministic(std::istream& in) {
+  std::uint32_t header[BinaryFormat::kDenseHeaderWords];
+  if (!ReadWords(in, header, BinaryFormat::kDenseHeaderWords) || header[0] != BinaryFormat::kMagic ||
+      header[1] != BinaryFormat::kVersion || header[2] != static_cast<std::uint32_t>(Kind::kDenseDeterministic)) {
+    return std::nullopt;
+  }
+  const auto words_count = DenseWordsCount(header[3], header[4]);
+  if (words_count == 0) {
+    return std::nullopt;
+  }
+  std::vector<std::uint32_t> words(words_count);
+  std::copy(std::begin(header), std::end(header), words.begin());
+  if (!ReadWords(in, words.data() + BinaryFormat::kDenseHeaderWords, words_count - BinaryFormat::kDenseHeaderWords)) {
+    return std::nullopt;
+  }
+  auto view = DenseDeterministicView::FromWords(words.data(), words.size());
+  if (!view || !view->Verify()) {
+    return std::nullopt;
+  }
+  return view->ToDense();
+}
+
+DenseDeterministicView::DenseDeterministicView()
+    : symbols_{nullptr},
+      next_{nullptr},
+      final_{nullptr},
+      start_{DenseDeterministicAutomaton::kDeadState},
+      states_count_{0},
+      symbols_count_{0} {}
+
+std::optional<DenseDeterministicView> DenseDeterministicView::FromWords(const std::uint32_t* words, std::size_t size) {
+  if (size < BinaryFormat::kDenseHeaderWords || words[0] != BinaryFormat::kMagic ||
+      words[1] != BinaryFormat::kVersion || words[2] != static_cast<std::uint32_t>(Kind::kDenseDeterministic)) {
+    return std::nullopt;
+  }
+  DenseDeterministicView view;
+  view.states_count_ = words[3];
+  view.symbols_count_ = words[4];
+  view.start_ = words[5];
+  if (DenseWordsCount(view.states_count_, view.symbols_count_) != size) {
+    return std::nullopt;
+  }
+  if (view.start_ != DenseDeterministicAutomaton::kDeadState && view.start_ >= view.states_count_) {
+    return std::nullopt;
+  }
+  // int32_t may alias the words of its unsigned counterpart
+  view.symbols_ = reinterpret_cast<const Symbol*>(words + BinaryFormat::kDenseHeaderWords);
+  view.next_ = words + BinaryFormat::kDenseHeaderWords + view.symbols_count_;
+  view.final_ = view.next_ + view.states_count_ * view.symbols_count_;
+  for (std::size_t column = 1; column < view.symbols_count_; ++column) {
+    if (view.symbols_[column - 1] >= view.symbols_[column]) {
+      return std::nullopt;
+    }
+  }
+  return view;
+}
+
+bool DenseDeterministicView::Verify() const {
+  return std::all_of(next_, next_ + states_count_ * symbols_count_,
+                     [&](State to) { return to < states_count_ || to == DenseDeterministicAutomaton::kDeadState; });
+}
+
+bool DenseDeterministicView::Accepts(const Symbol* begin, const Symbol* end) const {
+  auto state = start_;
+  for (; begin != end && state != DenseDeterministicAutomaton::kDeadState; ++begin) {
+    if (*begin == kEpsilon) {
+      continue;
+    }
+    auto column = Column(*begin);
+    if (column == symbols_count_) {
+      return false;
+    }
+    state = next_[state * symbols_count_ + column];
+  }
+  return state != DenseDeterministicAutomaton::kDeadState && IsStateFinal(state);
+}
+
+DenseDeterministicAutomaton DenseDeterministicView::ToDense() const {
+  std::vector<State> final_states;
+  for (State state = 0; state != states_count_; ++state) {
+    if (IsStateFinal(state)) {
+      final_states.push_back(state);
+    }
+  }
+  return DenseDeterministicAutomaton{std::vector<Symbol>(symbols_, symbols_ + symbols_count_),
+                                     std::vector<State>(next_, next_ + states_count_ * symbols_count_), final_states,
+                                     start_};
+}
+
+MappedDeterministicAutomaton::MappedDeterministicAutomaton() : mapping_{nullptr}, mapping_size_{0} {}
+
+MappedDeterministicAutomaton::MappedDeterministicAutomaton(MappedDeterministicAutomaton&& other) noexcept
+    : mapping_{std::exchange(other.mapping_, nullptr)},
+      mapping_size_{std::exchange(other.mapping_size_, 0)},
+      buffer_{std::move(other.buffer_)},
+      view_{std::exchange(other.view_, DenseDeterministicView{})} {}
+
+MappedDeterministicAutomaton& MappedDeterministicAutomaton::operator=(MappedDeterministicAutomaton&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mapping_size_ = std::exchange(other.mapping_size_, 0);
+    buffer_ = std::move(other.buffer_);
+    view_ = std::exchange(other.view_, DenseDeterministicView{});
+  }
+  return *this;
+}
+
+MappedDeterministicAutomaton::~MappedDeterministicAutomaton() { Unmap(); }
+
+void MappedDeterministicAutomaton::Unmap() {
+#if CPPFORMLANG_HAS_MMAP
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+  }
+#endif
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+}
+
+std::optional<MappedDeterministicAutomaton> MappedDeterministicAutomaton::Open(const std::string& path) {
+  return Open(path, true);
+}
+
+std::optional<MappedDeterministicAutomaton> MappedDeterministicAutomaton::OpenUnchecked(const std::string& path) {
+  return Open(path, false);
+}
+
+std::optional<MappedDeterministicAutomaton> MappedDeterministicAutomaton::Open(const std::string& path, bool verify) {
+  MappedDeterministicAutomaton automaton;
+#if CPPFORMLANG_HAS_MMAP
+  if (IsLittleEndian()) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return std::nullopt;
+    }
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || info.st_size <= 0 || info.st_size % 4 != 0) {
+      close(fd);
+      return std::nullopt;
+    }
+    auto size = static_cast<std::size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+      return std::nullopt;
+    }
+    automaton.mapping_ = mapping;
+    automaton.mapping_size_ = size;
+    auto view = DenseDeterministicView::FromWords(static_cast<const std::uint32_t*>(mapping), size / 4);
+    if (!view || (verify && !view->Verify())) {
+      return std::nullopt;
+    }
+    automaton.view_ = *view;
+    return automaton;
+  }
+#endif
+  std::ifstream in{path, std::ios::binary | std::ios::ate};
+  if (!in) {
+    return std::nullopt;
+  }
+  auto size = static_cast<std::size_t>(in.tellg());
+  if (size == 0 || size % 4 != 0) {
+    return std::nullopt;
+  }
+  in.seekg(0);
+  automaton.buffer_.resize(size / 4);
+  if (!ReadWords(in, automaton.buffer_.data(), automaton.buffer_.size())) {
+    return std::nullopt;
+  }
+  auto view = DenseDeterministicView::FromWords(automaton.buffer_.data(), automaton.buffer_.size());
+  if (!view || (verify && !view->Verify())) {
+    return std::nullopt;
+  }
+  automaton.view_ = *view;
+  return automaton;
+}
+
+}  // namespace cppformlang::finite_automata
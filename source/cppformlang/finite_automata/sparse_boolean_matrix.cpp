@@ -0,0 +1,169 @@
+#include <cppformlang/finite_automata/sparse_boolean_matrix.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+constexpr std::size_t kChunkRows = 256;
+
+}  // namespace
+
+SparseBooleanMatrix::SparseBooleanMatrix() : SparseBooleanMatrix(0, 0) {}
+
+SparseBooleanMatrix::SparseBooleanMatrix(std::size_t rows, std::size_t columns)
+    : columns_count_{columns}, offsets_(rows + 1, 0) {}
+
+SparseBooleanMatrix::SparseBooleanMatrix(std::size_t rows, std::size_t columns,
+                                         std::vector<std::pair<std::uint32_t, std::uint32_t>> entries)
+    : columns_count_{columns}, offsets_(rows + 1, 0) {
+  std::sort(entries.begin(), entries.end());
+  entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+  columns_.reserve(entries.size());
+  for (auto& [row, column] : entries) {
+    assert(row < rows && column < columns);
+    ++offsets_[row + 1];
+    columns_.push_back(column);
+  }
+  for (std::size_t row = 0; row != rows; ++row) {
+    offsets_[row + 1] += offsets_[row];
+  }
+}
+
+SparseBooleanMatrix::SparseBooleanMatrix(std::size_t columns, std::vector<std::size_t> offsets,
+                                         std::vector<std::uint32_t> indices)
+    : columns_count_{columns}, offsets_{std::move(offsets)}, columns_{std::move(indices)} {}
+
+SparseBooleanMatrix SparseBooleanMatrix::Identity(std::size_t size) {
+  std::vector<std::size_t> offsets(size + 1);
+  std::vector<std::uint32_t> indices(size);
+  for (std::size_t i = 0; i != size; ++i) {
+    offsets[i + 1] = i + 1;
+    indices[i] = static_cast<std::uint32_t>(i);
+  }
+  return SparseBooleanMatrix{size, std::move(offsets), std::move(indices)};
+}
+
+bool SparseBooleanMatrix::Get(std::size_t row, std::size_t column) const {
+  return std::binary_search(RowBegin(row), RowEnd(row), static_cast<std::uint32_t>(column));
+}
+
+SparseBooleanMatrix SparseBooleanMatrix::Transpose() const {
+  std::vector<std::size_t> offsets(columns_count_ + 1, 0);
+  for (auto column : columns_) {
+    ++offsets[column + 1];
+  }
+  for (std::size_t column = 0; column != columns_count_; ++column) {
+    offsets[column + 1] += offsets[column];
+  }
+  std::vector<std::uint32_t> indices(columns_.size());
+  auto next = offsets;
+  // rows are visited in ascending order, so every transposed row comes out sorted
+  ForeachEntry([&](std::uint32_t row, std::uint32_t column) { indices[next[column]++] = row; });
+  return SparseBooleanMatrix{Rows(), std::move(offsets), std::move(indices)};
+}
+
+bool SparseBooleanMatrix::operator==(const SparseBooleanMatrix& other) const {
+  return columns_count_ == other.columns_count_ && offsets_ == other.offsets_ && columns_ == other.columns_;
+}
+
+template <typename RowFunctor>
+SparseBooleanMatrix SparseBooleanMatrix::BuildRows(std::size_t rows, std::size_t columns, utils::ThreadPool* pool,
+                                                   RowFunctor row) {
+  assert(columns <= std::numeric_limits<std::uint32_t>::max());
+  std::vector<std::size_t> offsets(rows + 1, 0);
+  if (pool == nullptr || pool->ThreadsCount() == 1 || rows <= kChunkRows) {
+    std::vector<std::uint32_t> indices;
+    for (std::size_t r = 0; r != rows; ++r) {
+      row(r, 0, indices);
+      offsets[r + 1] = indices.size();
+    }
+    return SparseBooleanMatrix{columns, std::move(offsets), std::move(indices)};
+  }
+  // every chunk of rows is built apart, the row sizes are kept in offsets and summed afterwards
+  std::vector<std::vector<std::uint32_t>> chunks((rows + kChunkRows - 1) / kChunkRows);
+  pool->ParallelFor(rows, kChunkRows, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+    auto& chunk = chunks[begin / kChunkRows];
+    for (auto r = begin; r != end; ++r) {
+      auto size = chunk.size();
+      row(r, worker, chunk);
+      offsets[r + 1] = chunk.size() - size;
+    }
+  });
+  for (std::size_t r = 0; r != rows; ++r) {
+    offsets[r + 1] += offsets[r];
+  }
+  std::vector<std::uint32_t> indices;
+  indices.reserve(offsets.back());
+  for (auto& chunk : chunks) {
+    indices.insert(indices.end(), chunk.begin(), chunk.end());
+  }
+  return SparseBooleanMatrix{columns, std::move(offsets), std::move(indices)};
+}
+
+SparseBooleanMatrix Add(const SparseBooleanMatrix& lhs, const SparseBooleanMatrix& rhs, utils::ThreadPool* pool) {
+  assert(lhs.Rows() == rhs.Rows() && lhs.Columns() == rhs.Columns());
+  return SparseBooleanMatrix::BuildRows(lhs.Rows(), lhs.Columns(), pool,
+                                        [&](std::size_t row, std::size_t, std::vector<std::uint32_t>& out) {
+                                          std::set_union(lhs.RowBegin(row), lhs.RowEnd(row), rhs.RowBegin(row),
+                                                         rhs.RowEnd(row), std::back_inserter(out));
+                                        });
+}
+
+SparseBooleanMatrix Subtract(const SparseBooleanMatrix& lhs, const SparseBooleanMatrix& rhs,
+                             utils::ThreadPool* pool) {
+  assert(lhs.Rows() == rhs.Rows() && lhs.Columns() == rhs.Columns());
+  return SparseBooleanMatrix::BuildRows(lhs.Rows(), lhs.Columns(), pool,
+                                        [&](std::size_t row, std::size_t, std::vector<std::uint32_t>& out) {
+                                          std::set_difference(lhs.RowBegin(row), lhs.RowEnd(row), rhs.RowBegin(row),
+                                                              rhs.RowEnd(row), std::back_inserter(out));
+                                        });
+}
+
+SparseBooleanMatrix Multiply(const SparseBooleanMatrix& lhs, const SparseBooleanMatrix& rhs,
+                             utils::ThreadPool* pool) {
+  assert(lhs.Columns() == rhs.Rows());
+  const auto threads = pool != nullptr ? pool->ThreadsCount() : 1;
+  // the marks of a thread are allocated on its first row, a mark equal to row + 1 means the column is taken
+  std::vector<std::vector<std::size_t>> marks(threads);
+  return SparseBooleanMatrix::BuildRows(
+      lhs.Rows(), rhs.Columns(), pool, [&](std::size_t row, std::size_t worker, std::vector<std::uint32_t>& out) {
+        auto& mark = marks[worker];
+        if (mark.empty()) {
+          mark.assign(rhs.Columns(), 0);
+        }
+        const auto size = out.size();
+        for (auto middle = lhs.RowBegin(row), end = lhs.RowEnd(row); middle != end; ++middle) {
+          for (auto column = rhs.RowBegin(*middle), last = rhs.RowEnd(*middle); column != last; ++column) {
+            if (mark[*column] != row + 1) {
+              mark[*column] = row + 1;
+              out.push_back(*column);
+            }
+          }
+        }
+        std::sort(out.begin() + static_cast<std::ptrdiff_t>(size), out.end());
+      });
+}
+
+SparseBooleanMatrix Kronecker(const SparseBooleanMatrix& lhs, const SparseBooleanMatrix& rhs,
+                              utils::ThreadPool* pool) {
+  return SparseBooleanMatrix::BuildRows(
+      lhs.Rows() * rhs.Rows(), lhs.Columns() * rhs.Columns(), pool,
+      [&](std::size_t row, std::size_t, std::vector<std::uint32_t>& out) {
+        const auto lhs_row = row / rhs.Rows();
+        const auto rhs_row = row % rhs.Rows();
+        for (auto lhs_column = lhs.RowBegin(lhs_row), end = lhs.RowEnd(lhs_row); lhs_column != end; ++lhs_column) {
+          const auto base = static_cast<std::uint32_t>(*lhs_column * rhs.Columns());
+          for (auto rhs_column = rhs.RowBegin(rhs_row), last = rhs.RowEnd(rhs_row); rhs_column != last; ++rhs_column) {
+            out.push_back(base + *rhs_column);
+          }
+        }
+      });
+}
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,121 @@
+#include <cppformlang/finite_automata/state_set.h>
+#include <cppformlang/finite_automata/stats.h>
+#include <utils/hash.h>
+
+#include <algorithm>
+
+namespace cppformlang::finite_automata {
+
+StateSet::StateSet(std::size_t universe)
+    : universe_{universe}, size_{0}, hash_{0}, dense_{false}, bits_((universe + 63) / 64, 0) {}
+
+std::size_t StateSet::HashState(std::uint32_t state) {
+  std::size_t seed = 0;
+  utils::hash_combine(seed, state);
+  return seed;
+}
+
+bool StateSet::Insert(std::uint32_t state) {
+  auto& word = bits_[state / 64];
+  auto bit = std::uint64_t{1} << (state % 64);
+  if ((word & bit) != 0) {
+    return false;
+  }
+  word |= bit;
+  if (!dense_) {
+    states_.push_back(state);
+    if (states_.size() > universe_ / 32) {
+      // the bitset is smaller from now on
+      states_.clear();
+      dense_ = true;
+    }
+  }
+  ++size_;
+  hash_ += HashState(state);
+  return true;
+}
+
+bool StateSet::Contains(std::uint32_t state) const { return (bits_[state / 64] >> (state % 64)) & 1U; }
+
+void StateSet::Clear() {
+  if (dense_) {
+    std::fill(bits_.begin(), bits_.end(), 0);
+  } else {
+    for (auto state : states_) {
+      bits_[state / 64] = 0;
+    }
+  }
+  size_ = 0;
+  hash_ = 0;
+  dense_ = false;
+  states_.clear();
+}
+
+StateSetTable::StateSetTable(std::size_t universe) : universe_{universe}, slots_(16, kEmpty) {}
+
+std::pair<std::uint32_t, bool> StateSetTable::Intern(const StateSet& set) {
+  const auto mask = slots_.size() - 1;
+  const auto home = set.Hash() & mask;
+  auto slot = home;
+  for (; slots_[slot] != kEmpty; slot = (slot + 1) & mask) {
+    if (Equals(entries_[slots_[slot]], set)) {
+      stats::RecordProbes(((slot - home) & mask) + 1);
+      return {slots_[slot], false};
+    }
+  }
+  stats::RecordProbes(((slot - home) & mask) + 1);
+  stats::RecordSubsetState();
+  auto id = static_cast<std::uint32_t>(entries_.size());
+  entries_.push_back(Entry{arena_.size(), set.Hash(), static_cast<std::uint32_t>(set.Size()), set.IsDense()});
+  if (set.IsDense()) {
+    for (auto word : set.Bits()) {
+      arena_.push_back(static_cast<std::uint32_t>(word));
+      arena_.push_back(static_cast<std::uint32_t>(word >> 32));
+    }
+  } else {
+    const auto offset = arena_.size();
+    arena_.insert(arena_.end(), set.States().begin(), set.States().end());
+    std::sort(arena_.begin() + static_cast<std::ptrdiff_t>(offset), arena_.end());
+  }
+  slots_[slot] = id;
+  if (entries_.size() * 2 > slots_.size()) {
+    Grow();
+  }
+  return {id, true};
+}
+
+bool StateSetTable::Equals(const Entry& entry, const StateSet& set) const {
+  if (entry.hash != set.Hash() || entry.size != set.Size()) {
+    return false;
+  }
+  const auto* data = arena_.data() + entry.offset;
+  if (!entry.dense) {
+    // the sizes are equal, so the sets are equal if the set has every stored state
+    return std::all_of(data, data + entry.size, [&](std::uint32_t state) { return set.Contains(state); });
+  }
+  for (std::size_t word = 0; word != DenseWords(); ++word) {
+    if ((std::uint64_t{data[2 * word]} | std::uint64_t{data[2 * word + 1]} << 32) != set.Bits()[word]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void StateSetTable::Grow() {
+  slots_.assign(slots_.size() * 2, kEmpty);
+  const auto mask = slots_.size() - 1;
+  for (std::uint32_t id = 0; id != entries_.size(); ++id) {
+    auto slot = entries_[id].hash & mask;
+    while (slots_[slot] != kEmpty) {
+      slot = (slot + 1) & mask;
+    }
+    slots_[slot] = id;
+  }
+}
+
+std::size_t StateSetTable::MemoryUsage() const {
+  return arena_.capacity() * sizeof(std::uint32_t) + entries_.capacity() * sizeof(Entry) +
+         slots_.capacity() * sizeof(std::uint32_t);
+}
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,22 @@
+#include <cppformlang/finite_automata/stats.h>
+
+#include <atomic>
+
+namespace cppformlang::finite_automata {
+
+namespace {
+
+thread_local AlgorithmStats thread_stats;
+std::atomic<TraceSink> trace_sink{nullptr};
+
+}  // namespace
+
+AlgorithmStats& ThreadStats() { return thread_stats; }
+
+void ResetThreadStats() { thread_stats = AlgorithmStats{}; }
+
+void SetTraceSink(TraceSink sink) { trace_sink.store(sink, std::memory_order_release); }
+
+TraceSink GetTraceSink() { return trace_sink.load(std::memory_order_acquire); }
+
+}  // namespace cppformlang::finite_automata
@@ -0,0 +1,135 @@
+#include <cppformlang/finite_automata/alphabet_partition.h>
+#include <cppformlang/finite_automata/dense_deterministic_automaton.h>
+#include <cppformlang/finite_automata/lazy_deterministic_automaton.h>
+#include <cppformlang/finite_automata/minimization.h>
+#include <doctest/doctest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// a digit followed by letters, every digit and every letter but 'x' act alike
+NondeterministicFiniteAutomaton Identifier() {
+  NondeterministicFiniteAutomaton nfa;
+  for (Symbol digit = '0'; digit <= '9'; ++digit) {
+    nfa.AddTransition(0, digit, 1);
+  }
+  for (Symbol letter = 'a'; letter <= 'z'; ++letter) {
+    nfa.AddTransition(1, letter, letter == 'x' ? 2 : 1);
+    nfa.AddTransition(2, letter, 2);
+  }
+  for (Symbol wide = 1000; wide != 1010; ++wide) {
+    nfa.AddTransition(1, wide, 1);
+    nfa.AddTransition(2, wide, 2);
+  }
+  nfa.SetStartState(0, true);
+  nfa.SetFinalState(1, true);
+  return nfa;
+}
+
+bool Accepts(const DenseDeterministicAutomaton& dfa, const std::vector<Symbol>& word) {
+  return dfa.Accepts(word.data(), word.data() + word.size());
+}
+
+}  // namespace
+
+TEST_CASE("AlphabetPartitionLookup") {
+  AlphabetPartition partition{{-5, 3, 4, 200, 300, 301, 302, 400}, {7, 1, 1, 7, 2, 2, 1, 2}};
+  CHECK(partition.ClassesCount() == 3);
+  CHECK(partition.SymbolsCount() == 8);
+  CHECK(partition.Class(-5) == 0);
+  CHECK(partition.Class(3) == 1);
+  CHECK(partition.Class(200) == 0);
+  CHECK(partition.Class(301) == 2);
+  CHECK(partition.Class(302) == 1);
+  CHECK(partition.Class(400) == 2);
+  CHECK(partition.Class(5) == 3);
+  CHECK(partition.Class(-4) == 3);
+  CHECK(partition.Class(303) == 3);
+  CHECK(partition.Class(1 << 30) == 3);
+  CHECK(partition.Representative(1) == 3);
+
+  std::vector<Symbol> members;
+  partition.ForeachSymbolOf(2, [&](Symbol symbol) { members.push_back(symbol); });
+  CHECK(members == std::vector<Symbol>{300, 301, 400});
+
+  AlphabetPartition empty;
+  CHECK(empty.ClassesCount() == 0);
+  CHECK(empty.Class('a') == 0);
+}
+
+TEST_CASE("AlphabetPartitionOfAutomaton") {
+  auto nfa = Identifier();
+  AlphabetPartition partition{CompactNondeterministicAutomaton{nfa}};
+  // digits, letters with the wide symbols, and 'x'
+  CHECK(partition.ClassesCount() == 3);
+  CHECK(partition.Class('0') == partition.Class('9'));
+  CHECK(partition.Class('a') == partition.Class(1005));
+  CHECK(partition.Class('a') != partition.Class('x'));
+  CHECK(partition.Class('a') != partition.Class('5'));
+}
+
+TEST_CASE("DenseDeterministicAutomatonRunsOverClasses") {
+  auto nfa = Identifier();
+  DenseDeterministicAutomaton dfa{nfa};
+  CHECK(dfa.SymbolsCount() == 46);
+  CHECK(dfa.ColumnsCount() == 3);
+  CHECK(dfa.StatesCount() * dfa.ColumnsCount() == 9);
+  CHECK(Accepts(dfa, {'7', 'a', 1003, 'z'}));
+  CHECK_FALSE(Accepts(dfa, {'7', 'a', 'x'}));
+  CHECK_FALSE(Accepts(dfa, {'a'}));
+  CHECK_FALSE(Accepts(dfa, {'7', 2000}));
+
+  auto minimal = dfa.Minimize();
+  CHECK(minimal.ColumnsCount() <= dfa.ColumnsCount());
+  CHECK(Accepts(minimal, {'0', 1009}));
+  CHECK_FALSE(Accepts(minimal, {'0', 'x', 'a'}));
+
+  // the general representation gets every symbol of a class back, 'x' only led to the dropped state
+  auto back = minimal.ToNondeterministic();
+  CHECK(back.SymbolsCount() == 45);
+  CHECK(DenseDeterministicAutomaton{back}.ColumnsCount() == 2);
+}
+
+TEST_CASE("RawTablesMergeEqualColumns") {
+  // columns 'a' and 'c' are equal
+  DenseDeterministicAutomaton dfa{{'a', 'b', 'c'}, {1, 0, 1, 1, 1, 1}, {1}, 0};
+  CHECK(dfa.ColumnsCount() == 2);
+  CHECK(dfa.Column('a') == dfa.Column('c'));
+  CHECK(Accepts(dfa, {'c'}));
+  CHECK_FALSE(Accepts(dfa, {'b'}));
+  CHECK(Accepts(dfa, {'b', 'a', 'b'}));
+}
+
+TEST_CASE("DeterminizationOverClassesKeepsTheLanguage") {
+  std::mt19937 random{11};
+  for (auto round = 0; round != 30; ++round) {
+    NondeterministicFiniteAutomaton nfa;
+    for (auto i = 0; i != 40; ++i) {
+      nfa.AddTransition(random() % 8, static_cast<Symbol>('a' + random() % 6), random() % 8);
+    }
+    nfa.AddTransition(0, kEpsilon, random() % 8);
+    nfa.SetStartState(0, true);
+    nfa.SetFinalState(random() % 8, true);
+    nfa.SetFinalState(0, true);
+    auto dfa = nfa.ToDeterministic();
+    auto parallel = nfa.ToDeterministic(2);
+    DenseDeterministicAutomaton dense{nfa};
+    LazyDeterministicAutomaton lazy{nfa};
+    for (auto word = 0; word != 50; ++word) {
+      std::vector<Symbol> symbols(random() % 8);
+      for (auto& symbol : symbols) {
+        symbol = static_cast<Symbol>('a' + random() % 7);
+      }
+      auto expected = nfa.Accepts(symbols.data(), symbols.data() + symbols.size());
+      CHECK(dfa.Accepts(symbols.data(), symbols.data() + symbols.size()) == expected);
+      CHECK(parallel.Accepts(symbols.data(), symbols.data() + symbols.size()) == expected);
+      CHECK(Accepts(dense, symbols) == expected);
+      CHECK(lazy.Accepts(symbols.data(), symbols.data() + symbols.size()) == expected);
+    }
+  }
+}
@@ -0,0 +1,39 @@
+#include <cppformlang/finite_automata/batch.h>
+#include <doctest/doctest.h>
+#include <words.h>
+
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+TEST_CASE("AcceptsBatch") {
+  auto nfa = NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)|c*");
+  std::vector<Symbol> symbols;
+  std::vector<std::size_t> offsets{0};
+  for (auto& word : words::AllWords({'a', 'b', 'c', '?'}, 6)) {
+    symbols.insert(symbols.end(), word.begin(), word.end());
+    offsets.push_back(symbols.size());
+  }
+  WordBatch batch{symbols.data(), offsets.data(), offsets.size() - 1};
+  std::vector<std::uint64_t> expected((batch.words_count + 63) / 64, 0);
+  for (std::size_t i = 0; i != batch.words_count; ++i) {
+    if (nfa.Accepts(symbols.data() + offsets[i], symbols.data() + offsets[i + 1])) {
+      expected[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+  }
+
+  CompactNondeterministicAutomaton compact{nfa};
+  DenseDeterministicAutomaton dense{nfa};
+  for (std::size_t threads : {1, 3}) {
+    utils::ThreadPool pool{threads};
+    std::vector<std::uint64_t> result(expected.size(), ~std::uint64_t{0});
+    AcceptsBatch(compact, batch, result.data(), &pool);
+    CHECK(result == expected);
+    result.assign(expected.size(), ~std::uint64_t{0});
+    AcceptsBatch(dense, batch, result.data(), &pool);
+    CHECK(result == expected);
+  }
+  std::vector<std::uint64_t> result(expected.size(), 0);
+  AcceptsBatch(compact, batch, result.data());
+  CHECK(result == expected);
+}
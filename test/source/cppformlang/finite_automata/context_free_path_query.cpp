@@ -0,0 +1,88 @@
+#include <cppformlang/finite_automata/context_free_path_query.h>
+#include <doctest/doctest.h>
+
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// S -> a S b | a b, or S -> a S b | eps when nullable, by a plain fixpoint
+std::vector<std::pair<State, State>> Reference(std::size_t vertices, const std::vector<LabeledEdge>& edges,
+                                               bool nullable) {
+  std::set<std::pair<State, State>> result;
+  if (nullable) {
+    for (State vertex = 0; vertex != vertices; ++vertex) {
+      result.emplace(vertex, vertex);
+    }
+  }
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (auto& a : edges) {
+      for (auto& b : edges) {
+        if (a.label != 'a' || b.label != 'b') {
+          continue;
+        }
+        bool derived = !nullable && a.to == b.from;
+        derived = derived || result.count({a.to, b.from}) != 0;
+        if (derived && result.emplace(a.from, b.to).second) {
+          changed = true;
+        }
+      }
+    }
+  }
+  return {result.begin(), result.end()};
+}
+
+NondeterministicFiniteAutomaton Box(bool nullable) {
+  NondeterministicFiniteAutomaton box;
+  box.AddTransition(1, 'a', 2);
+  box.AddTransition(2, 'S', 3);
+  box.AddTransition(3, 'b', 4);
+  box.AddTransition(2, 'b', 4);
+  box.SetStartState(1, true);
+  box.SetFinalState(4, true);
+  if (nullable) {
+    box.RemoveTransition(2, 'b', 4);
+    box.SetFinalState(1, true);
+  }
+  return box;
+}
+
+}  // namespace
+
+TEST_CASE("ContextFreePathQuery") {
+  // a cycle of a of length 3 and a cycle of b of length 2 sharing vertex 0
+  const std::vector<LabeledEdge> edges{{0, 'a', 1}, {1, 'a', 2}, {2, 'a', 0}, {0, 'b', 3}, {3, 'b', 0}, {2, 'c', 3}};
+  LabeledGraph graph{4, edges};
+  for (bool nullable : {false, true}) {
+    RecursiveAutomaton rsm;
+    rsm.SetInitLabel('S');
+    rsm.AddBox('S', Box(nullable));
+    auto expected = Reference(4, edges, nullable);
+    CHECK(expected.size() > 4);
+    CHECK(ContextFreePathQuery(rsm, graph) == expected);
+    utils::ThreadPool pool{2};
+    CHECK(ContextFreePathQuery(rsm, graph, &pool) == expected);
+  }
+}
+
+TEST_CASE("ContextFreeReachability") {
+  // S -> A b, A -> a | a A
+  RecursiveAutomaton rsm;
+  rsm.SetInitLabel('S');
+  NondeterministicFiniteAutomaton s;
+  s.AddTransition(1, 'A', 2);
+  s.AddTransition(2, 'b', 3);
+  s.SetStartState(1, true);
+  s.SetFinalState(3, true);
+  rsm.AddBox('S', s);
+  rsm.AddBox('A', NondeterministicFiniteAutomaton::FromRegex("a+a*"));
+  LabeledGraph graph{4, {{0, 'a', 1}, {1, 'a', 2}, {2, 'b', 3}, {1, 'b', 0}}};
+  auto reachability = ContextFreeReachability(rsm, graph);
+  REQUIRE(reachability.size() == 2);
+  CHECK(reachability.at('A').NonZeros() == 3);
+  CHECK(ContextFreePathQuery(rsm, graph) == std::vector<std::pair<State, State>>{{0, 0}, {0, 3}, {1, 3}});
+}
@@ -0,0 +1,34 @@
+#include <cppformlang/finite_automata/dense_deterministic_automaton.h>
+#include <doctest/doctest.h>
+#include <words.h>
+
+#include <iterator>
+
+using namespace cppformlang::finite_automata;
+
+TEST_CASE("DenseDeterministicAutomaton") {
+  for (auto regex : {"a|b+c*", "(a|b)*+a+(a|b)", "(a+b)*+c", "a*"}) {
+    auto nfa = NondeterministicFiniteAutomaton::FromRegex(regex);
+    DenseDeterministicAutomaton dense{nfa};
+    // every word over {a, b, c} up to length 5, plus an unknown symbol
+    for (auto& word : words::AllWords({'a', 'b', 'c'}, 5)) {
+      CHECK(dense.Accepts(word.data(), word.data() + word.size()) ==
+            nfa.Accepts(word.data(), word.data() + word.size()));
+    }
+    const Symbol unknown[] = {'a', 'z'};
+    CHECK_FALSE(dense.Accepts(std::begin(unknown), std::end(unknown)));
+  }
+}
+
+TEST_CASE("DenseDeterministicAutomatonRoundTrip") {
+  auto dfa = NondeterministicFiniteAutomaton::FromRegex("a+b*").ToDeterministic();
+  DenseDeterministicAutomaton dense{dfa};
+  CHECK(dense.StatesCount() == dfa.StatesCount());
+  CHECK(dense.FinalStatesCount() == dfa.FinalStatesCount());
+  auto back = dense.ToNondeterministic();
+  CHECK(back.IsDeterministic());
+  CHECK(back.TransitionsCount() == dfa.TransitionsCount());
+  const Symbol word[] = {'a', 'b', 'b'};
+  CHECK(dense.Accepts(std::begin(word), std::end(word)));
+  CHECK_FALSE(dense.Accepts(std::begin(word) + 1, std::end(word)));
+}
@@ -0,0 +1,84 @@
+#include <cppformlang/finite_automata/epsilon_closure_table.h>
+#include <cppformlang/finite_automata/nondeterministic_finite_automaton.h>
+#include <doctest/doctest.h>
+#include <words.h>
+
+#include <unordered_set>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+TEST_CASE("EpsilonClosureTable") {
+  NondeterministicFiniteAutomaton nfa;
+  // 1 -> 2 -> 3 -> 1 is a cycle, 3 -> 4 -> 5 is a tail
+  nfa.AddTransition(1, kEpsilon, 2);
+  nfa.AddTransition(2, kEpsilon, 3);
+  nfa.AddTransition(3, kEpsilon, 1);
+  nfa.AddTransition(3, kEpsilon, 4);
+  nfa.AddTransition(4, kEpsilon, 5);
+  nfa.AddTransition(5, 'a', 6);
+  nfa.AddTransition(6, kEpsilon, 6);
+  EpsilonClosureTable closures{nfa};
+  CHECK(closures.ComponentsCount() == 3);
+  nfa.ForeachState([&](State state) {
+    std::unordered_set<State> closure;
+    closures.ForeachInClosure(state, [&](State to) { CHECK(closure.insert(to).second); });
+    CHECK(closure == nfa.Eclose(state));
+    CHECK(closures.ClosureSize(state) == closure.size());
+  });
+}
+
+TEST_CASE("RemoveEpsilon") {
+  for (auto regex : {"a|b+c*", "(a|b)*+a+(a|b)", "((a|b)*+c)*", "a*+b*"}) {
+    auto nfa = NondeterministicFiniteAutomaton::FromRegex(regex);
+    auto epsilon_free = nfa.RemoveEpsilon();
+    epsilon_free.ForeachSymbol([](Symbol symbol) { CHECK(symbol != kEpsilon); });
+    CHECK(epsilon_free.StatesCount() <= nfa.StatesCount());
+    for (auto& word : words::AllWords({'a', 'b', 'c', '?'}, 5)) {
+      CHECK(epsilon_free.Accepts(word.data(), word.data() + word.size()) ==
+            nfa.Accepts(word.data(), word.data() + word.size()));
+    }
+  }
+}
+
+TEST_CASE("RemoveEpsilonOnlyEmptyWord") {
+  NondeterministicFiniteAutomaton nfa;
+  nfa.AddTransition(1, kEpsilon, 2);
+  nfa.SetStartState(1, true);
+  nfa.SetFinalState(2, true);
+  auto epsilon_free = nfa.RemoveEpsilon();
+  CHECK(epsilon_free.StatesCount() == 1);
+  CHECK(epsilon_free.TransitionsCount() == 0);
+  CHECK(epsilon_free.IsStateStart(1));
+  CHECK(epsilon_free.IsStateFinal(1));
+  const Symbol word[] = {'a'};
+  CHECK(epsilon_free.Accepts(word, word));
+  CHECK_FALSE(epsilon_free.Accepts(word, word + 1));
+}
+
+TEST_CASE("AcceptsAfterEpsilonEdits") {
+  NondeterministicFiniteAutomaton nfa;
+  nfa.AddTransition(1, 'a', 2);
+  nfa.AddTransition(3, 'b', 4);
+  nfa.SetStartState(1, true);
+  nfa.SetFinalState(4, true);
+  const Symbol word[] = {'a', 'b'};
+  CHECK_FALSE(nfa.Accepts(word, word + 2));
+
+  // the closures kept by the first call must follow the epsilon transitions
+  nfa.AddTransition(2, kEpsilon, 3);
+  CHECK(nfa.Accepts(word, word + 2));
+  auto copy = nfa;
+  nfa.RemoveTransition(2, kEpsilon, 3);
+  CHECK_FALSE(nfa.Accepts(word, word + 2));
+  CHECK(copy.Accepts(word, word + 2));
+
+  // edits through the base class and assignments are seen too
+  FiniteAutomaton<NondeterministicTransitions>& base = nfa;
+  base.AddTransition(2, kEpsilon, 3);
+  CHECK(nfa.Accepts(word, word + 2));
+  base.RemoveTransition(2, kEpsilon, 3);
+  CHECK_FALSE(nfa.Accepts(word, word + 2));
+  base = copy;
+  CHECK(nfa.Accepts(word, word + 2));
+}
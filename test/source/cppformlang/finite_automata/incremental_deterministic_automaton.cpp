@@ -0,0 +1,114 @@
+#include <cppformlang/finite_automata/dense_deterministic_automaton.h>
+#include <cppformlang/finite_automata/incremental_deterministic_automaton.h>
+#include <doctest/doctest.h>
+#include <words.h>
+
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+void CheckSameAsSource(IncrementalDeterministicAutomaton& dfa) {
+  const auto& nfa = dfa.Source();
+  for (auto& word : words::AllWords({'a', 'b', 'c', '?'}, 4)) {
+    CHECK(dfa.Accepts(word.data(), word.data() + word.size()) == nfa.Accepts(word.data(), word.data() + word.size()));
+  }
+  // ToDeterministic expects a start state
+  const auto expected = nfa.StartStatesCount() == 0 ? 0 : DenseDeterministicAutomaton{nfa}.Minimize().StatesCount();
+  CHECK(dfa.Minimal().StatesCount() == expected);
+  CHECK(dfa.Minimal().ToNondeterministic().IsEquivalent(nfa));
+}
+
+}  // namespace
+
+TEST_CASE("IncrementalDeterministicAutomaton") {
+  auto nfa = NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)");
+  IncrementalDeterministicAutomaton dfa{nfa};
+  CheckSameAsSource(dfa);
+  CHECK(dfa.Minimal().StatesCount() == 4);
+  CHECK(dfa.AddTransition(100, 'c', 101));
+  CHECK_FALSE(dfa.AddTransition(100, 'c', 101));
+  CHECK_FALSE(dfa.RemoveTransition(100, 'b', 101));
+  CheckSameAsSource(dfa);
+
+  CHECK(IncrementalDeterministicAutomaton{}.Minimal().StatesCount() == 0);
+  IncrementalDeterministicAutomaton empty;
+  CHECK_FALSE(empty.SetStartState(0, true));
+  CHECK(empty.AddTransition(0, 'a', 1));
+  CHECK(empty.SetStartState(0, true));
+  CHECK(empty.SetFinalState(1, true));
+  CheckSameAsSource(empty);
+  CHECK(empty.RemoveTransition(0, 'a', 1));
+  CHECK_FALSE(empty.Source().IsStateStart(0));
+  CheckSameAsSource(empty);
+}
+
+TEST_CASE("IncrementalDeterministicAutomatonRandomEdits") {
+  std::mt19937 random{31};
+  IncrementalDeterministicAutomaton dfa;
+  std::vector<std::tuple<State, Symbol, State>> transitions;
+  for (auto round = 0; round != 300; ++round) {
+    const State from = random() % 8;
+    const State to = random() % 8;
+    const Symbol by = random() % 10 == 0 ? kEpsilon : static_cast<Symbol>("abc"[random() % 3]);
+    switch (random() % 6) {
+      case 0:
+      case 1:
+      case 2:
+        if (dfa.AddTransition(from, by, to)) {
+          transitions.emplace_back(from, by, to);
+        }
+        break;
+      case 3:
+        if (!transitions.empty()) {
+          auto at = random() % transitions.size();
+          auto [edge_from, edge_by, edge_to] = transitions[at];
+          CHECK(dfa.RemoveTransition(edge_from, edge_by, edge_to));
+          transitions.erase(transitions.begin() + static_cast<std::ptrdiff_t>(at));
+        }
+        break;
+      case 4:
+        dfa.SetStartState(from, random() % 3 != 0);
+        break;
+      default:
+        dfa.SetFinalState(from, random() % 2 == 0);
+        break;
+    }
+    CHECK(dfa.Source().TransitionsCount() == transitions.size());
+    if (round % 10 == 0) {
+      CheckSameAsSource(dfa);
+    }
+  }
+  CheckSameAsSource(dfa);
+}
+
+TEST_CASE("IncrementalDeterministicAutomatonLocalUpdates") {
+  // a chain of 1000 states, every subset is a single state
+  NondeterministicFiniteAutomaton nfa;
+  for (State state = 0; state != 1000; ++state) {
+    nfa.AddTransition(state, 'a', state + 1);
+  }
+  nfa.SetStartState(0, true);
+  nfa.SetFinalState(1000, true);
+  IncrementalDeterministicAutomaton dfa{nfa};
+  CHECK(dfa.StatesCount() == 1001);
+
+  CHECK(dfa.AddTransition(998, 'b', 1000));
+  CHECK(dfa.LastUpdateSize() == 1);
+  CHECK(dfa.AddTransition(998, 'a', 1000));
+  CHECK(dfa.LastUpdateSize() == 2);
+  CHECK(dfa.StatesCount() == 1002);
+  CHECK(dfa.RemoveTransition(998, 'a', 1000));
+  CHECK(dfa.LastUpdateSize() == 1);
+  CHECK(dfa.SetFinalState(998, true));
+  CHECK(dfa.LastUpdateSize() == 0);
+
+  std::vector<Symbol> word(998, 'a');
+  CHECK(dfa.Accepts(word.data(), word.data() + word.size()));
+  word.push_back('b');
+  CHECK(dfa.Accepts(word.data(), word.data() + word.size()));
+  CHECK(dfa.Minimal().StatesCount() == 1001);
+}
@@ -0,0 +1,30 @@
+#include <cppformlang/finite_automata/interleaved_matcher.h>
+#include <doctest/doctest.h>
+#include <words.h>
+
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+TEST_CASE("AcceptsInterleaved") {
+  DenseDeterministicAutomaton dfa{NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)|c*+a")};
+  std::vector<Symbol> symbols;
+  std::vector<std::size_t> offsets{0};
+  for (auto& word : words::AllWords({'a', 'b', 'c', kEpsilon, 1000}, 5)) {
+    symbols.insert(symbols.end(), word.begin(), word.end());
+    offsets.push_back(symbols.size());
+  }
+  WordBatch batch{symbols.data(), offsets.data(), offsets.size() - 1};
+  std::vector<std::uint64_t> expected((batch.words_count + 63) / 64, 0);
+  for (std::size_t i = 0; i != batch.words_count; ++i) {
+    if (dfa.Accepts(symbols.data() + offsets[i], symbols.data() + offsets[i + 1])) {
+      expected[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+  }
+  for (auto kernel : {InterleavedKernel::kScalar, InterleavedKernel::kAvx2}) {
+    std::vector<std::uint64_t> result(expected.size(), ~std::uint64_t{0});
+    AcceptsInterleaved(dfa, batch, 0, 640, result.data(), kernel);
+    AcceptsInterleaved(dfa, batch, 640, batch.words_count, result.data(), kernel);
+    CHECK(result == expected);
+  }
+}
@@ -0,0 +1,100 @@
+#include <cppformlang/finite_automata/nondeterministic_finite_automaton.h>
+#include <cppformlang/finite_automata/product.h>
+#include <cppformlang/finite_automata/regex.h>
+#include <doctest/doctest.h>
+
+#include <string>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+NondeterministicFiniteAutomaton Automaton(const std::string& regex) {
+  return Regex::Parse(regex)->ToPositionAutomaton();
+}
+
+bool Accepts(const NondeterministicFiniteAutomaton& nfa, const std::vector<Symbol>& word) {
+  return nfa.Accepts(word.data(), word.data() + word.size());
+}
+
+}  // namespace
+
+TEST_CASE("IsEmpty") {
+  std::vector<Symbol> word;
+  CHECK_FALSE(Automaton("a*+b+(c|a+b)").IsEmpty(&word));
+  CHECK(word == std::vector<Symbol>{'b', 'c'});
+  CHECK(NondeterministicFiniteAutomaton{}.IsEmpty());
+  CHECK(Automaton("").IsEmpty());
+
+  NondeterministicFiniteAutomaton unreachable;
+  unreachable.AddTransition(0, 'a', 1);
+  unreachable.AddTransition(2, 'b', 3);
+  unreachable.SetStartState(0, true);
+  unreachable.SetFinalState(3, true);
+  CHECK(unreachable.IsEmpty());
+  unreachable.AddTransition(1, kEpsilon, 2);
+  CHECK_FALSE(unreachable.IsEmpty(&word));
+  CHECK(word == std::vector<Symbol>{'a', 'b'});
+
+  auto nullable = Automaton("a*");
+  CHECK_FALSE(nullable.IsEmpty(&word));
+  CHECK(word.empty());
+}
+
+TEST_CASE("IsSubsetOf") {
+  std::vector<Symbol> counterexample;
+  CHECK(Automaton("a+b").IsSubsetOf(Automaton("(a|b)*")));
+  CHECK(Automaton("(a+b)*").IsSubsetOf(Automaton("(a|b)*")));
+  CHECK(Automaton("").IsSubsetOf(Automaton("a")));
+
+  auto left = Automaton("(a|b)*");
+  auto right = Automaton("a*+(b+a*)*+a");
+  CHECK_FALSE(left.IsSubsetOf(right, &counterexample));
+  CHECK(Accepts(left, counterexample));
+  CHECK_FALSE(Accepts(right, counterexample));
+  CHECK(counterexample.empty());
+  CHECK(Automaton("a|b+c").IsSubsetOf(Automaton("a|b+c|d"), &counterexample));
+  CHECK_FALSE(Automaton("a|b+c|d").IsSubsetOf(Automaton("a|b+c"), &counterexample));
+  CHECK(counterexample == std::vector<Symbol>{'d'});
+}
+
+TEST_CASE("IsEquivalentDeterministic") {
+  auto left = Automaton("(a|b)*+a+(a|b)").ToDeterministic();
+  auto right = left.Minimize();
+  REQUIRE(left.IsDeterministic());
+  REQUIRE(right.IsDeterministic());
+  CHECK(left.StatesCount() != right.StatesCount());
+  CHECK(left.IsEquivalent(right));
+
+  std::vector<Symbol> counterexample;
+  auto other = Automaton("(a|b)*+b+(a|b)").Minimize();
+  CHECK_FALSE(right.IsEquivalent(other, &counterexample));
+  CHECK(Accepts(right, counterexample) != Accepts(other, counterexample));
+  CHECK(counterexample.size() == 2);
+
+  // a symbol read by one automaton only leads the other one to its dead state
+  auto wider = Automaton("a*|c").Minimize();
+  CHECK_FALSE(Automaton("a*").Minimize().IsEquivalent(wider, &counterexample));
+  CHECK(counterexample == std::vector<Symbol>{'c'});
+  CHECK(NondeterministicFiniteAutomaton{}.IsEquivalent(Automaton("")));
+}
+
+TEST_CASE("IsEquivalentNondeterministic") {
+  const std::vector<std::string> regexes{"(a|b)*+a",   "(a|b)*+a|a", "(b*+a)+(b*+a)*", "a*+b*",
+                                         "(a|b)*",     "(a*+b*)*",   "a+(b+a)*",       "(a+b)*+a"};
+  for (auto& left_regex : regexes) {
+    for (auto& right_regex : regexes) {
+      auto left = Automaton(left_regex);
+      auto right = Automaton(right_regex);
+      std::vector<Symbol> counterexample;
+      CHECK(left.IsSubsetOf(right, &counterexample) == IsDifferenceEmpty(left, right));
+      bool equivalent = IsDifferenceEmpty(left, right) && IsDifferenceEmpty(right, left);
+      CHECK(left.IsEquivalent(right, &counterexample) == equivalent);
+      if (!equivalent) {
+        CHECK(Accepts(left, counterexample) != Accepts(right, counterexample));
+      }
+      CHECK(left.ToDeterministic().IsEquivalent(right.Minimize()) == equivalent);
+    }
+  }
+}
@@ -0,0 +1,37 @@
+#include <cppformlang/finite_automata/lazy_deterministic_automaton.h>
+#include <doctest/doctest.h>
+#include <words.h>
+
+#include <string>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+void CheckSameAsNondeterministic(LazyDeterministicAutomaton& lazy, const NondeterministicFiniteAutomaton& nfa) {
+  for (auto& word : words::AllWords({'a', 'b', 'c', '?'}, 6)) {
+    CHECK(lazy.Accepts(word.data(), word.data() + word.size()) == nfa.Accepts(word.data(), word.data() + word.size()));
+  }
+}
+
+}  // namespace
+
+TEST_CASE("LazyDeterministicAutomaton") {
+  for (auto regex : {"a|b+c*", "(a|b)*+a+(a|b)+(a|b)", "((a|b)*+c)*"}) {
+    auto nfa = NondeterministicFiniteAutomaton::FromRegex(regex);
+    LazyDeterministicAutomaton lazy{nfa};
+    CHECK(lazy.CachedStatesCount() == 0);
+    CheckSameAsNondeterministic(lazy, nfa);
+    CHECK(lazy.CachedStatesCount() <= nfa.ToDeterministic().StatesCount());
+    CHECK(lazy.FlushesCount() == 0);
+  }
+}
+
+TEST_CASE("LazyDeterministicAutomatonFlush") {
+  auto nfa = NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)+(a|b)+(a|b)");
+  LazyDeterministicAutomaton lazy{nfa, 512};
+  CheckSameAsNondeterministic(lazy, nfa);
+  CHECK(lazy.FlushesCount() > 0);
+  CHECK(lazy.MemoryUsage() <= 512);
+}
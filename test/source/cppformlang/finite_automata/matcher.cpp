@@ -0,0 +1,44 @@
+#include <cppformlang/finite_automata/matcher.h>
+#include <doctest/doctest.h>
+#include <words.h>
+
+#include <algorithm>
+
+using namespace cppformlang::finite_automata;
+
+TEST_CASE("MatcherChunks") {
+  auto nfa = NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)+(a|b)");
+  CompactNondeterministicAutomaton compact{nfa};
+  DenseDeterministicAutomaton dense{nfa};
+  Matcher nondeterministic{compact};
+  Matcher deterministic{dense};
+  for (auto& word : words::AllWords({'a', 'b'}, 10)) {
+    auto expected = nfa.Accepts(word.data(), word.data() + word.size());
+    for (auto* matcher : {&nondeterministic, &deterministic}) {
+      matcher->Reset();
+      // feed the word in chunks of 1, 2, 3, ... symbols
+      for (std::size_t begin = 0, size = 1; begin < word.size(); begin += size++) {
+        matcher->Feed(word.data() + begin, word.data() + std::min(begin + size, word.size()));
+      }
+      CHECK(matcher->IsAccepting() == expected);
+    }
+  }
+}
+
+TEST_CASE("MatcherDeadState") {
+  auto nfa = NondeterministicFiniteAutomaton::FromRegex("a+b*");
+  CompactNondeterministicAutomaton compact{nfa};
+  DenseDeterministicAutomaton dense{nfa};
+  const Symbol prefix[] = {'a', 'b'};
+  const Symbol tail[] = {'a', 'b'};
+  for (auto matcher : {Matcher{compact}, Matcher{dense}}) {
+    CHECK(matcher.Feed(std::begin(prefix), std::end(prefix)));
+    CHECK(matcher.IsAccepting());
+    CHECK_FALSE(matcher.Feed(std::begin(tail), std::end(tail)));
+    CHECK(matcher.IsDead());
+    CHECK_FALSE(matcher.IsAccepting());
+    matcher.Reset();
+    CHECK_FALSE(matcher.IsDead());
+    CHECK_FALSE(matcher.IsAccepting());
+  }
+}
@@ -0,0 +1,64 @@
+#include <cppformlang/finite_automata/minimization.h>
+#include <doctest/doctest.h>
+
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+TEST_CASE("Minimize") {
+  auto nfa = NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)");
+  auto minimal = nfa.Minimize();
+  CHECK(minimal.IsDeterministic());
+  CHECK(minimal.StatesCount() == 4);
+  CHECK(minimal.FinalStatesCount() == 2);
+  CHECK(NondeterministicFiniteAutomaton::FromRegex("a*+a*").Minimize().StatesCount() == 1);
+  CHECK(NondeterministicFiniteAutomaton::FromRegex("a+b|a+c").Minimize().StatesCount() == 3);
+
+  const Symbol word[] = {'b', 'a', 'b', 'b'};
+  CHECK(minimal.Accepts(std::begin(word), std::end(word) - 1));
+  CHECK_FALSE(minimal.Accepts(std::begin(word), std::end(word)));
+
+  // only the empty word, the minimal automaton has a single state without transitions
+  NondeterministicFiniteAutomaton empty;
+  empty.AddTransition(0, kEpsilon, 1);
+  empty.SetStartState(0, true);
+  empty.SetFinalState(1, true);
+  auto minimal_empty = empty.Minimize();
+  CHECK(minimal_empty.StatesCount() == 1);
+  CHECK(minimal_empty.Accepts(nullptr, nullptr));
+  CHECK_FALSE(minimal_empty.Accepts(std::begin(word), std::begin(word) + 1));
+}
+
+TEST_CASE("HopcroftMatchesMoore") {
+  std::mt19937 random{42};
+  for (auto round = 0; round != 20; ++round) {
+    const std::size_t states = 1 + random() % 60;
+    const std::size_t columns = 1 + random() % 3;
+    std::vector<Symbol> symbols;
+    for (std::size_t column = 0; column != columns; ++column) {
+      symbols.push_back(static_cast<Symbol>('a' + column));
+    }
+    std::vector<State> next(states * columns);
+    for (auto& to : next) {
+      to = random() % 5 == 0 ? DenseDeterministicAutomaton::kDeadState : static_cast<State>(random() % states);
+    }
+    std::vector<State> final_states;
+    for (State state = 0; state != states; ++state) {
+      if (random() % 3 == 0) {
+        final_states.push_back(state);
+      }
+    }
+    DenseDeterministicAutomaton dfa{symbols, next, final_states, 0};
+    auto hopcroft = HopcroftPartition(dfa, FinalLabels(dfa));
+    auto moore = MoorePartition(dfa, FinalLabels(dfa));
+    REQUIRE(hopcroft.size() == moore.size());
+    std::set<std::pair<State, State>> pairs;
+    for (std::size_t state = 0; state != hopcroft.size(); ++state) {
+      pairs.emplace(hopcroft[state], moore[state]);
+    }
+    CHECK(pairs.size() == std::set<State>(hopcroft.begin(), hopcroft.end()).size());
+    CHECK(pairs.size() == std::set<State>(moore.begin(), moore.end()).size());
+  }
+}
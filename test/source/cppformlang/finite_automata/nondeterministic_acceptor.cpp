@@ -0,0 +1,46 @@
+#include <cppformlang/finite_automata/nondeterministic_acceptor.h>
+#include <doctest/doctest.h>
+#include <words.h>
+
+#include <string>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+void CheckSameAsGeneric(const NondeterministicAcceptor& acceptor) {
+  for (auto& word : words::AllWords({'a', 'b', 'c', '?'}, 5)) {
+    CHECK(acceptor.Accepts(word.data(), word.data() + word.size()) ==
+          acceptor.Automaton().Accepts(word.data(), word.data() + word.size()));
+  }
+}
+
+}  // namespace
+
+TEST_CASE("BitParallelAccepts") {
+  for (auto regex : {"a|b+c*", "(a|b)*+a+(a|b)", "(a+b)*+c", "a*", "((a|b)*+c)*"}) {
+    NondeterministicAcceptor acceptor{NondeterministicFiniteAutomaton::FromRegex(regex)};
+    CHECK(acceptor.Engine() == AcceptsEngine::kBitParallel);
+    CheckSameAsGeneric(acceptor);
+  }
+}
+
+TEST_CASE("BitParallelFallback") {
+  std::string regex = "(a|b)*";
+  for (auto i = 0; i != 40; ++i) {
+    regex += i % 2 == 0 ? "+(a|c)*" : "+(b|c)*";
+  }
+  NondeterministicAcceptor wide{NondeterministicFiniteAutomaton::FromRegex(regex)};
+  CHECK(wide.Automaton().StatesCount() > 64);
+  CHECK(wide.Engine() == AcceptsEngine::kBitParallel);
+  CheckSameAsGeneric(wide);
+
+  for (auto i = 0; i != 100; ++i) {
+    regex += "+(a|c)";
+  }
+  NondeterministicAcceptor large{NondeterministicFiniteAutomaton::FromRegex(regex)};
+  CHECK(large.Engine() == AcceptsEngine::kGeneric);
+  NondeterministicAcceptor generic{NondeterministicFiniteAutomaton::FromRegex("a*"), AcceptsEngine::kGeneric};
+  CHECK(generic.Engine() == AcceptsEngine::kGeneric);
+}
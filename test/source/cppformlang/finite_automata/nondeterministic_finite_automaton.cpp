@@ -1,7 +1,11 @@
+#include <cppformlang/finite_automata/dense_deterministic_automaton.h>
 #include <cppformlang/finite_automata/nondeterministic_finite_automaton.h>
 #include <doctest/doctest.h>
 
+#include <memory_resource>
+#include <set>
 #include <string>
+#include <tuple>
 
 using namespace cppformlang::finite_automata;
 
@@ -44,3 +48,199 @@ TEST_CASE("ToDeterministic2") {
   CHECK(dfa.StatesCount() == 2);
   CHECK(dfa.TransitionsCount() == 4);
 }
+
+TEST_CASE("ToDeterministicEmptyWord") {
+  NondeterministicFiniteAutomaton nfa;
+  nfa.AddTransition(0, kEpsilon, 1);
+  nfa.SetStartState(0, true);
+  nfa.SetFinalState(1, true);
+  const Symbol word[] = {'a'};
+  REQUIRE(nfa.Accepts(nullptr, nullptr));
+
+  auto dfa = nfa.ToDeterministic();
+  CHECK(dfa.StatesCount() == 1);
+  CHECK(dfa.StartStatesCount() == 1);
+  CHECK(dfa.FinalStatesCount() == 1);
+  CHECK(dfa.Accepts(nullptr, nullptr));
+  CHECK_FALSE(dfa.Accepts(word, word + 1));
+
+  DenseDeterministicAutomaton dense{nfa};
+  CHECK(dense.Accepts(nullptr, nullptr));
+  CHECK_FALSE(dense.Accepts(word, word + 1));
+}
+
+TEST_CASE("UnionWithIsolatedStart") {
+  NondeterministicFiniteAutomaton empty;
+  empty.AddState(1);
+  empty.SetStartState(1, true);
+  empty.SetFinalState(1, true);
+  auto nfa = NondeterministicFiniteAutomaton::FromRegex("a");
+  nfa.Union(empty);
+  CHECK(nfa.StatesCount() == 3);
+  const Symbol word[] = {'a', 'a'};
+  auto dfa = nfa.ToDeterministic();
+  CHECK(dfa.Accepts(nullptr, nullptr));
+  CHECK(dfa.Accepts(word, word + 1));
+  CHECK_FALSE(dfa.Accepts(word, word + 2));
+
+  nfa.Concatenate(empty);
+  CHECK(nfa.ToDeterministic().Accepts(word, word + 1));
+}
+
+TEST_CASE("AddState") {
+  NondeterministicFiniteAutomaton nfa;
+  CHECK_FALSE(nfa.SetStartState(1, true));
+  CHECK(nfa.AddState(1));
+  CHECK_FALSE(nfa.AddState(1));
+  CHECK(nfa.SetStartState(1, true));
+  CHECK(nfa.SetFinalState(1, true));
+  CHECK(nfa.StatesCount() == 1);
+  CHECK(nfa.Accepts(nullptr, nullptr));
+
+  CHECK(nfa.AddTransition(1, 'a', 2));
+  CHECK(nfa.RemoveTransition(1, 'a', 2));
+  CHECK(nfa.StatesCount() == 1);
+  CHECK(nfa.IsStateStart(1));
+  CHECK(nfa.IsStateFinal(1));
+}
+
+TEST_CASE("Reverse") {
+  NondeterministicFiniteAutomaton nfa;
+  nfa.AddTransition(0, 'a', 1);
+  nfa.AddTransition(1, 'b', 2);
+  nfa.AddTransition(1, 'c', 1);
+  nfa.SetStartState(0, true);
+  nfa.SetFinalState(2, true);
+  auto reversed = nfa.Reverse();
+  const Symbol word[] = {'b', 'c', 'c', 'a'};
+  CHECK(reversed.Accepts(word, word + 4));
+  CHECK_FALSE(reversed.Accepts(word + 1, word + 4));
+  CHECK_FALSE(nfa.Accepts(word, word + 4));
+  CHECK(reversed.Reverse().Accepts(word + 3, word + 4) == nfa.Accepts(word + 3, word + 4));
+
+  // an isolated start and final state stays a state of the reversed automaton
+  NondeterministicFiniteAutomaton isolated;
+  isolated.AddState(1);
+  isolated.SetStartState(1, true);
+  isolated.SetFinalState(1, true);
+  isolated.AddTransition(2, 'a', 3);
+  auto reversed_isolated = isolated.Reverse();
+  CHECK(reversed_isolated.StatesCount() == 3);
+  CHECK(reversed_isolated.IsStateStart(1));
+  CHECK(reversed_isolated.IsStateFinal(1));
+  CHECK(reversed_isolated.ToDeterministic().Accepts(nullptr, nullptr));
+}
+
+TEST_CASE("ParallelToDeterministic") {
+  auto nfa = NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)+(a|b)+(a|b)|(b+c)*");
+  auto sequential = nfa.ToDeterministic();
+  std::set<std::tuple<State, Symbol, State>> expected;
+  sequential.ForeachTransition([&](State from, Symbol by, State to) { expected.emplace(from, by, to); });
+  for (std::size_t threads : {1, 2, 4, 8}) {
+    auto dfa = nfa.ToDeterministic(threads);
+    CHECK(dfa.IsDeterministic());
+    CHECK(dfa.StatesCount() == sequential.StatesCount());
+    CHECK(dfa.FinalStatesCount() == sequential.FinalStatesCount());
+    std::set<std::tuple<State, Symbol, State>> transitions;
+    dfa.ForeachTransition([&](State from, Symbol by, State to) { transitions.emplace(from, by, to); });
+    CHECK(transitions == expected);
+    const Symbol word[] = {'a', 'b', 'a', 'b'};
+    CHECK(dfa.Accepts(std::begin(word), std::end(word)));
+  }
+
+  // only the empty word, the start subset has no transitions
+  NondeterministicFiniteAutomaton empty;
+  empty.AddTransition(0, kEpsilon, 1);
+  empty.SetStartState(0, true);
+  empty.SetFinalState(1, true);
+  auto empty_sequential = empty.ToDeterministic();
+  for (std::size_t threads : {1, 4}) {
+    auto dfa = empty.ToDeterministic(threads);
+    CHECK(dfa.StatesCount() == empty_sequential.StatesCount());
+    CHECK(dfa.StartStatesCount() == empty_sequential.StartStatesCount());
+    CHECK(dfa.FinalStatesCount() == empty_sequential.FinalStatesCount());
+    CHECK(dfa.Accepts(nullptr, nullptr));
+  }
+}
+
+namespace {
+
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  std::size_t allocations = 0;
+  std::size_t live = 0;
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    ++live;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+    --live;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+}  // namespace
+
+TEST_CASE("MemoryResource") {
+  const std::string regex = "(a|b)*+a+(a|b)";
+  const Symbol accepted[] = {'b', 'a', 'b'};
+  const Symbol rejected[] = {'a', 'b', 'b'};
+  CountingResource resource;
+  {
+    auto nfa = NondeterministicFiniteAutomaton::FromRegex(regex, &resource);
+    CHECK(nfa.GetResource() == &resource);
+    CHECK(resource.allocations > 0);
+    CHECK(nfa.Accepts(std::begin(accepted), std::end(accepted)));
+    CHECK_FALSE(nfa.Accepts(std::begin(rejected), std::end(rejected)));
+
+    // a copy does not keep the resource of the source
+    auto copy = nfa;
+    CHECK(copy.GetResource() == std::pmr::get_default_resource());
+    CHECK(copy.StatesCount() == nfa.StatesCount());
+    CHECK(copy.TransitionsCount() == nfa.TransitionsCount());
+  }
+  CHECK(resource.live == 0);
+
+  auto nfa = NondeterministicFiniteAutomaton::FromRegex(regex);
+  CHECK(nfa.GetResource() == std::pmr::get_default_resource());
+  CHECK(nfa.Accepts(std::begin(accepted), std::end(accepted)));
+
+  NondeterministicFiniteAutomaton arena{OwnArena{}};
+  CHECK(arena.GetResource() != std::pmr::get_default_resource());
+  arena = nfa;
+  CHECK(arena.GetResource() != std::pmr::get_default_resource());
+  auto moved = std::move(arena);
+  CHECK(moved.TransitionsCount() == nfa.TransitionsCount());
+  CHECK(moved.Accepts(std::begin(accepted), std::end(accepted)));
+  CHECK_FALSE(moved.Accepts(std::begin(rejected), std::end(rejected)));
+}
+
+TEST_CASE("MoveOwnArena") {
+  // the moved-from automaton still allocates from the arena it gave away
+  NondeterministicFiniteAutomaton source{OwnArena{}};
+  source.AddTransition(1, 'a', 2);
+  auto moved = std::move(source);
+  source = NondeterministicFiniteAutomaton::FromRegex("a+b");
+  source.AddTransition(3, 'c', 4);
+  moved.AddTransition(2, 'b', 3);
+  CHECK(source.TransitionsCount() > 1);
+  CHECK(moved.TransitionsCount() == 2);
+
+  NondeterministicFiniteAutomaton a{OwnArena{}};
+  a.AddTransition(1, 'a', 2);
+  NondeterministicFiniteAutomaton b;
+  b.AddTransition(1, 'b', 2);
+  std::swap(a, b);
+  a.AddTransition(0, 'c', 1);
+  a.SetStartState(0, true);
+  a.SetFinalState(2, true);
+  CHECK(a.TransitionsCount() == 2);
+  const Symbol word[] = {'c', 'b'};
+  CHECK(a.Accepts(std::begin(word), std::end(word)));
+  CHECK_FALSE(a.Accepts(std::begin(word) + 1, std::end(word)));
+  CHECK(b.TransitionsCount() == 1);
+}
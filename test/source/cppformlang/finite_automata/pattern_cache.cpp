@@ -0,0 +1,94 @@
+#include <cppformlang/finite_automata/pattern_cache.h>
+#include <doctest/doctest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+bool Accepts(const PatternCache::Automaton& dfa, const std::string& word) {
+  std::vector<Symbol> symbols(word.begin(), word.end());
+  return dfa->Accepts(symbols.data(), symbols.data() + symbols.size());
+}
+
+}  // namespace
+
+TEST_CASE("PatternCache") {
+  SUBCASE("hits and normalization") {
+    PatternCache cache{1 << 20};
+    auto first = cache.Get("(a|b)*+c");
+    REQUIRE(first != nullptr);
+    CHECK(Accepts(first, "abbac"));
+    CHECK(!Accepts(first, "abba"));
+    CHECK(cache.Get("(a|b)*+c") == first);
+    CHECK(cache.Get("((a|b))*c") == first);
+    CHECK(cache.Get("(a|b)*+d") != first);
+    auto stats = cache.GetStats();
+    CHECK(stats.hits == 2);
+    CHECK(stats.misses == 2);
+    CHECK(stats.entries == 2);
+    CHECK(stats.evictions == 0);
+    CHECK(stats.bytes > 0);
+
+    CHECK(cache.Get("(a|") == nullptr);
+    CHECK(cache.GetStats().misses == 2);
+    auto empty = cache.Get("");
+    REQUIRE(empty != nullptr);
+    CHECK(!Accepts(empty, ""));
+  }
+
+  SUBCASE("eviction of the least recently used") {
+    PatternCache cache{0};
+    auto dfa = cache.Get("a+b");
+    REQUIRE(dfa != nullptr);
+    CHECK(Accepts(dfa, "ab"));
+    CHECK(cache.GetStats().entries == 0);
+    CHECK(cache.GetStats().evictions == 1);
+
+    auto bytes = [] {
+      PatternCache probe{1 << 20};
+      probe.Get("a+b");
+      return probe.GetStats().bytes;
+    }();
+    PatternCache small{2 * bytes + bytes / 2};
+    small.Get("a+b");
+    small.Get("a+c");
+    small.Get("a+b");
+    small.Get("a+d");
+    CHECK(small.GetStats().evictions == 1);
+    CHECK(small.GetStats().entries == 2);
+    small.Get("a+b");
+    CHECK(small.GetStats().hits == 2);
+    small.Get("a+c");
+    CHECK(small.GetStats().misses == 4);
+
+    small.Clear();
+    CHECK(small.GetStats().entries == 0);
+    CHECK(small.GetStats().bytes == 0);
+  }
+
+  SUBCASE("single flight") {
+    PatternCache cache{1 << 20};
+    std::string regex = "(a|b)*+a";
+    for (auto i = 0; i != 12; ++i) {
+      regex += "+(a|b)";
+    }
+    std::vector<PatternCache::Automaton> results(8);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i != results.size(); ++i) {
+      threads.emplace_back([&, i] { results[i] = cache.Get(regex); });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (auto& result : results) {
+      CHECK(result == results[0]);
+    }
+    CHECK(cache.GetStats().misses == 1);
+    CHECK(cache.GetStats().hits == 7);
+    CHECK(results[0]->StatesCount() == 1U << 13);
+  }
+}
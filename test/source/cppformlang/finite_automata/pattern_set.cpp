@@ -0,0 +1,75 @@
+#include <cppformlang/finite_automata/pattern_set.h>
+#include <cppformlang/finite_automata/regex.h>
+#include <doctest/doctest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+std::vector<std::uint32_t> Match(const PatternSet& set, const std::string& word) {
+  std::vector<Symbol> symbols(word.begin(), word.end());
+  return set.Match(symbols.data(), symbols.data() + symbols.size());
+}
+
+}  // namespace
+
+TEST_CASE("PatternSetMatch") {
+  auto set = PatternSet::Compile({"a+b*", "a|b", "(a|b)*+c", "b*", "a+b", "a+b*"});
+  REQUIRE(set.has_value());
+  CHECK(set->PatternsCount() == 6);
+  CHECK(Match(*set, "a") == std::vector<std::uint32_t>{0, 1, 5});
+  CHECK(Match(*set, "ab") == std::vector<std::uint32_t>{0, 4, 5});
+  CHECK(Match(*set, "abb") == std::vector<std::uint32_t>{0, 5});
+  CHECK(Match(*set, "b") == std::vector<std::uint32_t>{1, 3});
+  CHECK(Match(*set, "babc") == std::vector<std::uint32_t>{2});
+  CHECK(Match(*set, "") == std::vector<std::uint32_t>{3});
+  CHECK(Match(*set, "ca").empty());
+  CHECK(Match(*set, "az").empty());
+}
+
+TEST_CASE("PatternSetRejectsMalformedPatterns") {
+  CHECK_FALSE(PatternSet::Compile({"a", "(a"}).has_value());
+  // the empty regex is the empty language
+  CHECK(Match(*PatternSet::Compile({""}), "").empty());
+  auto empty = PatternSet::Compile({});
+  REQUIRE(empty.has_value());
+  CHECK(Match(*empty, "").empty());
+  CHECK(Match(PatternSet{}, "a").empty());
+}
+
+TEST_CASE("PatternSetMinimizesWithinTagSets") {
+  // both patterns accept the same words, their states merge but keep both ids
+  auto set = PatternSet::Compile({"(a|b)*+a", "(a|b)*+a+(a|b)*+a|(a|b)*+a"});
+  REQUIRE(set.has_value());
+  CHECK(set->Automaton().StatesCount() == 2);
+  CHECK(set->TagSetsCount() == 2);
+  CHECK(Match(*set, "bba") == std::vector<std::uint32_t>{0, 1});
+}
+
+TEST_CASE("PatternSetAgreesWithSeparateAutomata") {
+  const std::vector<std::string> patterns{"(a|b)*+a+(a|b)+(a|b)", "a*+b+a*", "(a+b|b+a)*", "c|a+c*", "b*+c+b*"};
+  auto set = PatternSet::Compile(patterns);
+  REQUIRE(set.has_value());
+  std::vector<NondeterministicFiniteAutomaton> automata;
+  for (auto& pattern : patterns) {
+    automata.push_back(Regex::Parse(pattern)->ToPositionAutomaton());
+  }
+  std::mt19937 random{17};
+  for (auto round = 0; round != 500; ++round) {
+    std::vector<Symbol> word(random() % 10);
+    for (auto& symbol : word) {
+      symbol = static_cast<Symbol>('a' + random() % 3);
+    }
+    std::vector<std::uint32_t> expected;
+    for (std::uint32_t id = 0; id != automata.size(); ++id) {
+      if (automata[id].Accepts(word.data(), word.data() + word.size())) {
+        expected.push_back(id);
+      }
+    }
+    CHECK(set->Match(word.data(), word.data() + word.size()) == expected);
+  }
+}
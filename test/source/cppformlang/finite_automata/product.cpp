@@ -0,0 +1,71 @@
+#include <cppformlang/finite_automata/product.h>
+#include <doctest/doctest.h>
+#include <words.h>
+
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+using words::AllWords;
+
+namespace {
+
+bool Accepts(const NondeterministicFiniteAutomaton& nfa, const std::vector<Symbol>& word) {
+  return nfa.Accepts(word.data(), word.data() + word.size());
+}
+
+}  // namespace
+
+TEST_CASE("Intersect") {
+  auto left = NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)");
+  auto right = NondeterministicFiniteAutomaton::FromRegex("(a+b|b+a|c)*");
+  auto product = Intersect(left, right);
+  for (auto& word : AllWords({'a', 'b', 'c'}, 6)) {
+    CHECK(Accepts(product, word) == (Accepts(left, word) && Accepts(right, word)));
+  }
+  CHECK_FALSE(IsIntersectionEmpty(left, right));
+  CHECK(IsIntersectionEmpty(left, NondeterministicFiniteAutomaton::FromRegex("c*+b")));
+}
+
+TEST_CASE("Difference") {
+  auto left = NondeterministicFiniteAutomaton::FromRegex("(a|b)*+b");
+  auto right = NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+b|c");
+  auto difference = Difference(left, right);
+  for (auto& word : AllWords({'a', 'b', 'c'}, 6)) {
+    CHECK(Accepts(difference, word) == (Accepts(left, word) && !Accepts(right, word)));
+  }
+  CHECK_FALSE(IsDifferenceEmpty(left, right));
+  CHECK(IsDifferenceEmpty(right, NondeterministicFiniteAutomaton::FromRegex("(a|b|c)*+(b|c)")));
+}
+
+TEST_CASE("ProductsWithEmptyWord") {
+  auto as = NondeterministicFiniteAutomaton::FromRegex("a*");
+  auto bs = NondeterministicFiniteAutomaton::FromRegex("b*");
+  auto intersection = Intersect(as, bs);
+  CHECK(Accepts(intersection, {}));
+  CHECK_FALSE(IsIntersectionEmpty(as, bs));
+  CHECK(intersection.FinalStatesCount() == 1);
+  for (auto& word : AllWords({'a', 'b'}, 4)) {
+    CHECK(Accepts(intersection, word) == word.empty());
+  }
+
+  auto as_nonempty = NondeterministicFiniteAutomaton::FromRegex("a+a*");
+  auto difference = Difference(as, as_nonempty);
+  CHECK_FALSE(IsDifferenceEmpty(as, as_nonempty));
+  CHECK(difference.FinalStatesCount() == 1);
+  for (auto& word : AllWords({'a', 'b'}, 4)) {
+    CHECK(Accepts(difference, word) == word.empty());
+  }
+}
+
+TEST_CASE("Complement") {
+  auto nfa = NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)");
+  auto complement = Complement(nfa);
+  CHECK(complement.IsDeterministic());
+  // the complement is complete: every state reads every symbol
+  CHECK(complement.TransitionsCount() == complement.StatesCount() * 2);
+  for (auto& word : AllWords({'a', 'b'}, 7)) {
+    CHECK(Accepts(complement, word) != Accepts(nfa, word));
+  }
+  CHECK(IsIntersectionEmpty(nfa, complement));
+}
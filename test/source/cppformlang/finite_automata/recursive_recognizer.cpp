@@ -0,0 +1,205 @@
+#include <cppformlang/finite_automata/recursive_recognizer.h>
+#include <doctest/doctest.h>
+#include <words.h>
+
+#include <random>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+using words::AllWords;
+
+namespace {
+
+/// S -> ( S ) S | eps
+RecursiveAutomaton Dyck() {
+  NondeterministicFiniteAutomaton box;
+  box.AddTransition(1, '(', 2);
+  box.AddTransition(2, 'S', 3);
+  box.AddTransition(3, ')', 4);
+  box.AddTransition(4, 'S', 5);
+  box.SetStartState(1, true);
+  box.SetFinalState(1, true);
+  box.SetFinalState(5, true);
+  RecursiveAutomaton rsm;
+  rsm.SetInitLabel('S');
+  rsm.AddBox('S', box);
+  return rsm;
+}
+
+bool IsBalanced(const std::vector<Symbol>& word) {
+  int depth = 0;
+  for (auto symbol : word) {
+    depth += symbol == '(' ? 1 : -1;
+    if (depth < 0) {
+      return false;
+    }
+  }
+  return depth == 0;
+}
+
+}  // namespace
+
+TEST_CASE("RecursiveRecognizer") {
+  SUBCASE("Dyck words") {
+    RecursiveRecognizer recognizer{Dyck()};
+    CHECK(recognizer.IsNullable(recognizer.InitBox()));
+    for (auto& word : AllWords({'(', ')'}, 10)) {
+      CHECK(recognizer.Accepts(word.data(), word.data() + word.size()) == IsBalanced(word));
+    }
+    const std::vector<Symbol> unknown{'(', 'x', ')'};
+    CHECK(!recognizer.Accepts(unknown.data(), unknown.data() + unknown.size()));
+  }
+
+  SUBCASE("left recursion") {
+    // E -> E + a | a
+    NondeterministicFiniteAutomaton box;
+    box.AddTransition(1, 'E', 2);
+    box.AddTransition(2, '+', 3);
+    box.AddTransition(3, 'a', 4);
+    box.AddTransition(1, 'a', 4);
+    box.SetStartState(1, true);
+    box.SetFinalState(4, true);
+    RecursiveAutomaton rsm;
+    rsm.SetInitLabel('E');
+    rsm.AddBox('E', box);
+    auto regular = NondeterministicFiniteAutomaton::FromRegex("a+(\\++a)*");
+    for (auto& word : AllWords({'a', '+'}, 9)) {
+      CHECK(rsm.Accepts(word.data(), word.data() + word.size()) ==
+            regular.Accepts(word.data(), word.data() + word.size()));
+    }
+  }
+
+  SUBCASE("ambiguous grammar") {
+    // S -> S S | a
+    NondeterministicFiniteAutomaton box;
+    box.AddTransition(1, 'S', 2);
+    box.AddTransition(2, 'S', 3);
+    box.AddTransition(1, 'a', 3);
+    box.SetStartState(1, true);
+    box.SetFinalState(3, true);
+    RecursiveAutomaton rsm;
+    rsm.SetInitLabel('S');
+    rsm.AddBox('S', box);
+    RecursiveRecognizer recognizer{rsm};
+    std::vector<Symbol> word(60, 'a');
+    CHECK(recognizer.Accepts(word.data(), word.data() + word.size()));
+    word.push_back('b');
+    CHECK(!recognizer.Accepts(word.data(), word.data() + word.size()));
+    CHECK(!recognizer.Accepts(word.data(), word.data()));
+  }
+
+  SUBCASE("mutual recursion") {
+    // S -> a T | eps, T -> S b, so S derives a^n b^n
+    NondeterministicFiniteAutomaton s;
+    s.AddTransition(1, 'a', 2);
+    s.AddTransition(2, 'T', 3);
+    s.SetStartState(1, true);
+    s.SetFinalState(1, true);
+    s.SetFinalState(3, true);
+    NondeterministicFiniteAutomaton t;
+    t.AddTransition(1, 'S', 2);
+    t.AddTransition(2, 'b', 3);
+    t.SetStartState(1, true);
+    t.SetFinalState(3, true);
+    RecursiveAutomaton rsm;
+    rsm.SetInitLabel('S');
+    rsm.AddBox('S', s);
+    rsm.AddBox('T', t);
+    RecursiveRecognizer recognizer{rsm};
+    CHECK(!recognizer.IsNullable(1));
+    CHECK(recognizer.CanStart(1, recognizer.Terminal('a')));
+    CHECK(recognizer.CanStart(1, recognizer.Terminal('b')));
+    for (auto& word : AllWords({'a', 'b'}, 10)) {
+      const auto half = word.size() / 2;
+      bool expected = word.size() % 2 == 0;
+      for (std::size_t i = 0; i != word.size(); ++i) {
+        expected = expected && word[i] == (i < half ? 'a' : 'b');
+      }
+      CHECK(recognizer.Accepts(word.data(), word.data() + word.size()) == expected);
+    }
+  }
+
+  SUBCASE("epsilon transitions") {
+    // S -> eps written with an epsilon transition
+    NondeterministicFiniteAutomaton empty;
+    empty.AddTransition(0, kEpsilon, 1);
+    empty.SetStartState(0, true);
+    empty.SetFinalState(1, true);
+    RecursiveAutomaton rsm;
+    rsm.SetInitLabel('S');
+    rsm.AddBox('S', empty);
+    RecursiveRecognizer recognizer{rsm};
+    CHECK(recognizer.IsNullable(recognizer.InitBox()));
+    for (auto& word : AllWords({'a'}, 3)) {
+      CHECK(rsm.Accepts(word.data(), word.data() + word.size()) == word.empty());
+    }
+
+    // S -> ( S ) S | eps, the loop back to the start is an epsilon transition
+    NondeterministicFiniteAutomaton dyck;
+    dyck.AddTransition(1, '(', 2);
+    dyck.AddTransition(2, 'S', 3);
+    dyck.AddTransition(3, ')', 4);
+    dyck.AddTransition(4, kEpsilon, 1);
+    dyck.SetStartState(1, true);
+    dyck.SetFinalState(1, true);
+    rsm.AddBox('S', dyck);
+    for (auto& word : AllWords({'(', ')'}, 8)) {
+      CHECK(rsm.Accepts(word.data(), word.data() + word.size()) == IsBalanced(word));
+    }
+
+    // S -> a T b, T -> eps, the callee is nullable only by an epsilon transition
+    NondeterministicFiniteAutomaton s;
+    s.AddTransition(1, 'a', 2);
+    s.AddTransition(2, 'T', 3);
+    s.AddTransition(3, 'b', 4);
+    s.SetStartState(1, true);
+    s.SetFinalState(4, true);
+    RecursiveAutomaton nested;
+    nested.SetInitLabel('S');
+    nested.AddBox('S', s);
+    nested.AddBox('T', empty);
+    for (auto& word : AllWords({'a', 'b'}, 4)) {
+      CHECK(nested.Accepts(word.data(), word.data() + word.size()) == (word == std::vector<Symbol>{'a', 'b'}));
+    }
+  }
+
+  SUBCASE("missing init box") {
+    auto rsm = Dyck();
+    rsm.SetInitLabel('T');
+    const std::vector<Symbol> word{'(', ')'};
+    CHECK(!rsm.Accepts(word.data(), word.data() + word.size()));
+  }
+}
+
+TEST_CASE("RecursiveRecognizer AcceptsBatch") {
+  RecursiveRecognizer recognizer{Dyck()};
+  std::mt19937 random{11};
+  std::vector<Symbol> symbols;
+  std::vector<std::size_t> offsets{0};
+  std::vector<bool> expected;
+  for (auto word = 0; word != 300; ++word) {
+    // nearly balanced words, so that both answers are frequent
+    std::vector<Symbol> symbols_of_word;
+    int depth = 0;
+    for (auto length = random() % 40; length != 0; --length) {
+      bool open = depth == 0 || random() % 2 == 0;
+      symbols_of_word.push_back(open ? '(' : ')');
+      depth += open ? 1 : -1;
+    }
+    if (random() % 3 != 0) {
+      symbols_of_word.insert(symbols_of_word.end(), depth, ')');
+    }
+    expected.push_back(IsBalanced(symbols_of_word));
+    symbols.insert(symbols.end(), symbols_of_word.begin(), symbols_of_word.end());
+    offsets.push_back(symbols.size());
+  }
+  const WordBatch batch{symbols.data(), offsets.data(), expected.size()};
+  utils::ThreadPool pool{4};
+  for (auto* threads : {static_cast<utils::ThreadPool*>(nullptr), &pool}) {
+    std::vector<std::uint64_t> result((expected.size() + 63) / 64);
+    AcceptsBatch(recognizer, batch, result.data(), threads);
+    for (std::size_t i = 0; i != expected.size(); ++i) {
+      CHECK(((result[i / 64] >> (i % 64)) & 1U) == expected[i]);
+    }
+  }
+}
@@ -0,0 +1,56 @@
+#include <cppformlang/finite_automata/regex.h>
+#include <doctest/doctest.h>
+#include <words.h>
+
+#include <string>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+using words::AllWords;
+
+TEST_CASE("Regex Parse") {
+  for (std::string malformed : {"(", ")", "a|", "|a", "*a", "a+", "a\\", "()", "(a|)", "a)("}) {
+    CHECK(!Regex::Parse(malformed).has_value());
+  }
+
+  auto empty = Regex::Parse("");
+  REQUIRE(empty.has_value());
+  CHECK(empty->GetNode(empty->Root()).kind == Regex::Kind::kEmpty);
+  CHECK(empty->ToPositionAutomaton().StatesCount() == 0);
+
+  auto regex = Regex::Parse("a|b+c*");
+  REQUIRE(regex.has_value());
+  CHECK(regex->PositionsCount() == 3);
+  const auto& root = regex->GetNode(regex->Root());
+  CHECK(root.kind == Regex::Kind::kUnion);
+  CHECK(regex->GetNode(root.left).kind == Regex::Kind::kSymbol);
+  CHECK(regex->GetNode(root.right).kind == Regex::Kind::kConcatenation);
+}
+
+TEST_CASE("Regex ToString") {
+  for (std::string text : {"a|b+c*", "(a|b)+c", "a+(b+c)", "(a+b)*", "a**", "\\++\\*|\\(", "a|(b|c)"}) {
+    auto regex = Regex::Parse(text);
+    REQUIRE(regex.has_value());
+    CHECK(regex->ToString() == text);
+  }
+  // adjacent operands and redundant parentheses are written out canonically
+  CHECK(Regex::Parse("ab(c)")->ToString() == "a+b+c");
+  CHECK(Regex::Parse("((a|b))*")->ToString() == "(a|b)*");
+}
+
+TEST_CASE("Regex ToPositionAutomaton") {
+  for (std::string text : {"a", "a*", "a+b", "a|b", "(a|b)*+a+b", "(a+b|b)*+a*", "((a|b*)+c)*", "a*+b*+c*",
+                           "(a*)*+b", "a+(b|c+a)*+c|b*", "(((a)))+b|c+(a|b|c)*+a"}) {
+    auto regex = Regex::Parse(text);
+    REQUIRE(regex.has_value());
+    auto positions = regex->ToPositionAutomaton();
+    auto thompson = NondeterministicFiniteAutomaton::FromRegex(text);
+    CHECK(positions.StatesCount() == regex->PositionsCount() + 1);
+    positions.ForeachSymbol([](Symbol symbol) { CHECK(symbol != kEpsilon); });
+    for (auto& word : AllWords({'a', 'b', 'c'}, 6)) {
+      CHECK(positions.Accepts(word.data(), word.data() + word.size()) ==
+            thompson.Accepts(word.data(), word.data() + word.size()));
+    }
+  }
+}
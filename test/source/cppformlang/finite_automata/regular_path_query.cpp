@@ -0,0 +1,87 @@
+#include <cppformlang/finite_automata/regular_path_query.h>
+#include <doctest/doctest.h>
+
+#include <queue>
+#include <random>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// a plain search of the product from every source
+std::vector<std::pair<State, State>> Reference(std::size_t vertices, const std::vector<LabeledEdge>& edges,
+                                               const CompactNondeterministicAutomaton& query) {
+  std::set<std::pair<State, State>> result;
+  for (State source = 0; source != vertices; ++source) {
+    std::set<std::pair<State, std::uint32_t>> visited;
+    std::queue<std::pair<State, std::uint32_t>> to_process;
+    for (auto state : query.StartStates()) {
+      visited.emplace(source, state);
+      to_process.emplace(source, state);
+    }
+    while (!to_process.empty()) {
+      auto [vertex, state] = to_process.front();
+      to_process.pop();
+      if (query.IsStateFinal(state)) {
+        result.emplace(source, vertex);
+      }
+      for (auto& edge : edges) {
+        auto column = query.Column(edge.label);
+        if (edge.from != vertex || column == query.SymbolsCount()) {
+          continue;
+        }
+        for (auto to = query.SuccessorsBegin(state, column); to != query.SuccessorsEnd(state, column); ++to) {
+          if (visited.emplace(edge.to, *to).second) {
+            to_process.emplace(edge.to, *to);
+          }
+        }
+      }
+    }
+  }
+  return {result.begin(), result.end()};
+}
+
+}  // namespace
+
+TEST_CASE("LabeledGraph") {
+  LabeledGraph graph{4, {{0, 'b', 1}, {0, 'a', 2}, {0, 'a', 1}, {0, 'a', 1}, {2, 'c', 3}}};
+  CHECK(graph.VerticesCount() == 4);
+  CHECK(graph.EdgesCount() == 4);
+  CHECK(graph.LabelsCount() == 3);
+  CHECK(graph.Column('d') == 3);
+  std::vector<std::tuple<Symbol, State, State>> runs;
+  graph.ForeachRun(0, [&](std::uint32_t column, const State* begin, const State* end) {
+    runs.emplace_back(graph.GetLabel(column), *begin, static_cast<State>(end - begin));
+  });
+  CHECK(runs == std::vector<std::tuple<Symbol, State, State>>{{'a', 1, 2}, {'b', 1, 1}});
+}
+
+TEST_CASE("RegularPathQuery") {
+  std::mt19937 random{7};
+  const std::size_t vertices = 150;
+  std::vector<LabeledEdge> edges;
+  for (std::size_t i = 0; i != 300; ++i) {
+    edges.push_back(LabeledEdge{static_cast<State>(random() % vertices), static_cast<Symbol>('a' + random() % 3),
+                                static_cast<State>(random() % vertices)});
+  }
+  LabeledGraph graph{vertices, edges};
+  CompactNondeterministicAutomaton query{NondeterministicFiniteAutomaton::FromRegex("a+(b|c)*+a")};
+  auto expected = Reference(vertices, edges, query);
+  CHECK(!expected.empty());
+  CHECK(RegularPathQuery(graph, query) == expected);
+  utils::ThreadPool pool{4};
+  CHECK(RegularPathQuery(graph, query, &pool) == expected);
+
+  std::vector<State> sources{3, 70, 3};
+  std::vector<std::pair<State, State>> from_sources;
+  for (auto& pair : expected) {
+    if (pair.first == 3 || pair.first == 70) {
+      from_sources.push_back(pair);
+    }
+  }
+  CHECK(RegularPathQuery(graph, query, sources, &pool) == from_sources);
+}
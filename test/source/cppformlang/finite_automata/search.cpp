@@ -0,0 +1,101 @@
+#include <cppformlang/finite_automata/regex.h>
+#include <cppformlang/finite_automata/search.h>
+#include <doctest/doctest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+/// the leftmost-longest matches by Accepts over every substring
+std::vector<Match> NaiveFindAll(const std::string& regex, const std::string& text) {
+  auto nfa = Regex::Parse(regex)->ToPositionAutomaton();
+  std::vector<Symbol> symbols(text.begin(), text.end());
+  std::vector<Match> matches;
+  for (std::size_t from = 0; from <= text.size();) {
+    std::optional<Match> found;
+    for (auto begin = from; begin <= text.size() && !found; ++begin) {
+      for (auto end = text.size() + 1; end-- > begin;) {
+        if (nfa.Accepts(symbols.data() + begin, symbols.data() + end)) {
+          found = Match{begin, end};
+          break;
+        }
+      }
+    }
+    if (!found) {
+      break;
+    }
+    matches.push_back(*found);
+    from = found->end == found->begin ? found->end + 1 : found->end;
+  }
+  return matches;
+}
+
+}  // namespace
+
+TEST_CASE("SearchLeftmostLongest") {
+  auto searcher = Searcher::Compile("abcd|c");
+  REQUIRE(searcher.has_value());
+  CHECK(searcher->Search("abcd") == Match{0, 4});
+  CHECK(searcher->Search("abce") == Match{2, 3});
+  CHECK(searcher->Search("abcd", 1) == Match{2, 3});
+  CHECK_FALSE(searcher->Search("abd").has_value());
+
+  auto words = Searcher::Compile("(a|b)*+b");
+  CHECK(words->FindAll("xabbaby bz") == std::vector<Match>{{1, 6}, {8, 9}});
+  CHECK(words->FindAll("").empty());
+}
+
+TEST_CASE("SearchEmptyMatches") {
+  auto searcher = Searcher::Compile("a*");
+  CHECK(searcher->FindAll("baab") == std::vector<Match>{{0, 0}, {1, 3}, {3, 3}, {4, 4}});
+  CHECK(searcher->FindAll("") == std::vector<Match>{{0, 0}});
+  CHECK(searcher->Search("baab", 4) == Match{4, 4});
+  CHECK_FALSE(searcher->Search("baab", 5).has_value());
+
+  // the empty regex is the empty language
+  CHECK(Searcher::Compile("")->FindAll("ab").empty());
+  CHECK(Searcher{}.FindAll("ab").empty());
+  CHECK_FALSE(Searcher::Compile("(a").has_value());
+}
+
+TEST_CASE("SearchRequiredLiterals") {
+  auto prefix = Searcher::Compile("foo+(a|b)*");
+  CHECK(prefix->RequiredLiteral() == "foo");
+  CHECK(prefix->IsLiteralPrefix());
+  CHECK(prefix->FindAll("xfofooabxfoob") == std::vector<Match>{{3, 8}, {9, 13}});
+
+  auto inner = Searcher::Compile("(a|b)*+needle+(a|b)");
+  CHECK(inner->RequiredLiteral() == "needle");
+  CHECK_FALSE(inner->IsLiteralPrefix());
+  CHECK(inner->FindAll("abneedlea needleb") == std::vector<Match>{{0, 9}, {10, 17}});
+  CHECK(inner->FindAll("abneedl").empty());
+
+  // the runs from the occurrences outgrow the text and the backward scan takes over
+  auto runs = Searcher::Compile("a+a*+b");
+  CHECK(runs->IsLiteralPrefix());
+  CHECK(runs->FindAll(std::string(300, 'a') + "cab") == std::vector<Match>{{301, 303}});
+
+  CHECK(Searcher::Compile("xab|yab")->RequiredLiteral() == "ab");
+  CHECK(Searcher::Compile("ab|cd")->RequiredLiteral().empty());
+  CHECK(Searcher::Compile("a*+b")->RequiredLiteral() == "b");
+}
+
+TEST_CASE("SearchAgreesWithSubstringAccepts") {
+  const std::vector<std::string> regexes{"a+b*", "(a|b)*+a+b", "a*", "ab+(c|a)*+b|b+c", "c+(ab)*+c", "(ab|a)+(bc|c)"};
+  std::mt19937 random{5};
+  for (auto& regex : regexes) {
+    auto searcher = Searcher::Compile(regex);
+    REQUIRE(searcher.has_value());
+    for (auto round = 0; round != 100; ++round) {
+      std::string text(random() % 16, 'a');
+      for (auto& byte : text) {
+        byte = static_cast<char>('a' + random() % 4);
+      }
+      CHECK(searcher->FindAll(text) == NaiveFindAll(regex, text));
+    }
+  }
+}
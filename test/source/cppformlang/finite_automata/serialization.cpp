@@ -0,0 +1,130 @@
+#include <cppformlang/finite_automata/serialization.h>
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+std::vector<std::vector<Symbol>> Words() {
+  std::vector<std::vector<Symbol>> words{{}};
+  for (std::size_t length = 1; length != 6; ++length) {
+    for (std::size_t mask = 0; mask != (std::size_t{1} << length); ++mask) {
+      std::vector<Symbol> word;
+      for (std::size_t i = 0; i != length; ++i) {
+        word.push_back((mask >> i) & 1U ? 'b' : 'a');
+      }
+      words.push_back(word);
+    }
+  }
+  words.push_back({'a', 'c'});
+  return words;
+}
+
+}  // namespace
+
+TEST_CASE("SaveLoadNondeterministic") {
+  auto nfa = NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)");
+  std::stringstream stream;
+  REQUIRE(Save(nfa, stream));
+  auto loaded = LoadNondeterministic(stream);
+  REQUIRE(loaded);
+  std::set<std::tuple<State, Symbol, State>> expected;
+  nfa.ForeachTransition([&](State from, Symbol by, State to) { expected.emplace(from, by, to); });
+  std::set<std::tuple<State, Symbol, State>> transitions;
+  loaded->ForeachTransition([&](State from, Symbol by, State to) { transitions.emplace(from, by, to); });
+  CHECK(transitions == expected);
+  CHECK(loaded->StartStatesCount() == nfa.StartStatesCount());
+  CHECK(loaded->FinalStatesCount() == nfa.FinalStatesCount());
+
+  std::stringstream truncated{stream.str().substr(0, 20)};
+  stream.seekg(0);
+  CHECK_FALSE(LoadNondeterministic(truncated));
+  CHECK_FALSE(LoadDenseDeterministic(stream));
+}
+
+TEST_CASE("SaveLoadIsolatedState") {
+  NondeterministicFiniteAutomaton nfa;
+  nfa.AddState(1);
+  nfa.SetStartState(1, true);
+  nfa.SetFinalState(1, true);
+  std::stringstream stream;
+  REQUIRE(Save(nfa, stream));
+  auto loaded = LoadNondeterministic(stream);
+  REQUIRE(loaded);
+  CHECK(loaded->StatesCount() == 1);
+  CHECK(loaded->IsStateStart(1));
+  CHECK(loaded->IsStateFinal(1));
+  CHECK(loaded->Accepts(nullptr, nullptr));
+}
+
+TEST_CASE("SaveLoadDense") {
+  DenseDeterministicAutomaton dfa{NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)")};
+  std::stringstream stream;
+  REQUIRE(Save(dfa, stream));
+  CHECK(stream.str().size() == 4 * (6 + 2 + 2 * dfa.StatesCount() + (dfa.StatesCount() + 31) / 32));
+  auto loaded = LoadDenseDeterministic(stream);
+  REQUIRE(loaded);
+  CHECK(loaded->StatesCount() == dfa.StatesCount());
+  CHECK(loaded->FinalStatesCount() == dfa.FinalStatesCount());
+  for (auto& word : Words()) {
+    CHECK(loaded->Accepts(word.data(), word.data() + word.size()) ==
+          dfa.Accepts(word.data(), word.data() + word.size()));
+  }
+
+  std::stringstream empty;
+  REQUIRE(Save(DenseDeterministicAutomaton{}, empty));
+  auto loaded_empty = LoadDenseDeterministic(empty);
+  REQUIRE(loaded_empty);
+  CHECK_FALSE(loaded_empty->Accepts(nullptr, nullptr));
+}
+
+TEST_CASE("MappedDeterministicAutomaton") {
+  DenseDeterministicAutomaton dfa{NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)+(a|b)")};
+  auto path = (std::filesystem::temp_directory_path() / "cppformlang_mapped_test.bin").string();
+  {
+    std::ofstream out{path, std::ios::binary};
+    REQUIRE(Save(dfa, out));
+  }
+  {
+    auto mapped = MappedDeterministicAutomaton::Open(path);
+    REQUIRE(mapped);
+    CHECK(mapped->View().Verify());
+    CHECK(mapped->View().StatesCount() == dfa.StatesCount());
+    for (auto& word : Words()) {
+      CHECK(mapped->Accepts(word.data(), word.data() + word.size()) ==
+            dfa.Accepts(word.data(), word.data() + word.size()));
+    }
+    auto moved = std::move(*mapped);
+    const Symbol word[] = {'a', 'b', 'b'};
+    CHECK(moved.Accepts(std::begin(word), std::end(word)));
+  }
+  {
+    std::stringstream saved;
+    REQUIRE(Save(dfa, saved));
+    auto bytes = saved.str();
+    // the first transition follows the header of 6 words and the symbols, in little-endian
+    bytes[4 * (6 + dfa.SymbolsCount())] = static_cast<char>(dfa.StatesCount() + 7);
+    std::fill_n(bytes.begin() + 4 * (6 + dfa.SymbolsCount()) + 1, 3, '\0');
+    std::ofstream out{path, std::ios::binary};
+    out << bytes;
+  }
+  CHECK_FALSE(MappedDeterministicAutomaton::Open(path));
+  CHECK(MappedDeterministicAutomaton::OpenUnchecked(path));
+  {
+    std::ofstream out{path, std::ios::binary};
+    REQUIRE(Save(NondeterministicFiniteAutomaton::FromRegex("a"), out));
+  }
+  CHECK_FALSE(MappedDeterministicAutomaton::Open(path));
+  std::remove(path.c_str());
+  CHECK_FALSE(MappedDeterministicAutomaton::Open(path));
+}
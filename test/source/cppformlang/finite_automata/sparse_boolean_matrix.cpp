@@ -0,0 +1,83 @@
+#include <cppformlang/finite_automata/sparse_boolean_matrix.h>
+#include <doctest/doctest.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+using Dense = std::vector<std::vector<bool>>;
+
+Dense RandomDense(std::size_t rows, std::size_t columns, std::mt19937& random) {
+  Dense dense(rows, std::vector<bool>(columns));
+  for (auto& row : dense) {
+    for (std::size_t column = 0; column != columns; ++column) {
+      row[column] = random() % 5 == 0;
+    }
+  }
+  return dense;
+}
+
+SparseBooleanMatrix ToSparse(const Dense& dense, std::size_t columns) {
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> entries;
+  for (std::uint32_t row = 0; row != dense.size(); ++row) {
+    for (std::uint32_t column = 0; column != columns; ++column) {
+      if (dense[row][column]) {
+        entries.emplace_back(row, column);
+      }
+    }
+  }
+  return SparseBooleanMatrix{dense.size(), columns, entries};
+}
+
+}  // namespace
+
+TEST_CASE("SparseBooleanMatrix") {
+  std::mt19937 random{3};
+  const std::size_t n = 300;
+  const std::size_t m = 270;
+  auto a = RandomDense(n, m, random);
+  auto b = RandomDense(n, m, random);
+  auto c = RandomDense(m, 40, random);
+  auto small = RandomDense(3, 4, random);
+
+  Dense sum(n, std::vector<bool>(m));
+  Dense difference(n, std::vector<bool>(m));
+  Dense transposed(m, std::vector<bool>(n));
+  Dense product(n, std::vector<bool>(40));
+  Dense kronecker(9, std::vector<bool>(16));
+  for (std::size_t i = 0; i != n; ++i) {
+    for (std::size_t j = 0; j != m; ++j) {
+      sum[i][j] = a[i][j] || b[i][j];
+      difference[i][j] = a[i][j] && !b[i][j];
+      transposed[j][i] = a[i][j];
+      for (std::size_t k = 0; k != 40; ++k) {
+        product[i][k] = product[i][k] || (a[i][j] && c[j][k]);
+      }
+    }
+  }
+  for (std::size_t i = 0; i != 9; ++i) {
+    for (std::size_t j = 0; j != 16; ++j) {
+      kronecker[i][j] = small[i / 3][j / 4] && small[i % 3][j % 4];
+    }
+  }
+
+  auto sparse_a = ToSparse(a, m);
+  auto sparse_b = ToSparse(b, m);
+  auto sparse_c = ToSparse(c, 40);
+  auto sparse_small = ToSparse(small, 4);
+  CHECK(sparse_a.Get(0, 0) == a[0][0]);
+  CHECK(sparse_a.Transpose() == ToSparse(transposed, n));
+  CHECK(SparseBooleanMatrix::Identity(3).NonZeros() == 3);
+
+  utils::ThreadPool pool{3};
+  for (auto* threads : {static_cast<utils::ThreadPool*>(nullptr), &pool}) {
+    CHECK(Add(sparse_a, sparse_b, threads) == ToSparse(sum, m));
+    CHECK(Subtract(sparse_a, sparse_b, threads) == ToSparse(difference, m));
+    CHECK(Multiply(sparse_a, sparse_c, threads) == ToSparse(product, 40));
+    CHECK(Kronecker(sparse_small, sparse_small, threads) == ToSparse(kronecker, 16));
+  }
+}
@@ -0,0 +1,90 @@
+#include <cppformlang/finite_automata/state_set.h>
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+TEST_CASE("StateSetHashIgnoresOrder") {
+  StateSet forward{1000};
+  StateSet backward{1000};
+  for (std::uint32_t state = 0; state != 20; ++state) {
+    CHECK(forward.Insert(state * 7));
+    CHECK(backward.Insert((19 - state) * 7));
+  }
+  CHECK_FALSE(forward.Insert(14));
+  CHECK(forward.Size() == 20);
+  CHECK(forward.Hash() == backward.Hash());
+  CHECK(forward.Contains(133));
+  CHECK_FALSE(forward.Contains(134));
+  CHECK_FALSE(forward.IsDense());
+
+  for (std::uint32_t state = 200; state != 300; ++state) {
+    forward.Insert(state);
+  }
+  CHECK(forward.IsDense());
+  CHECK(forward.Contains(250));
+  std::vector<std::uint32_t> states;
+  forward.ForeachState([&](std::uint32_t state) { states.push_back(state); });
+  CHECK(states.size() == forward.Size());
+  CHECK(std::is_sorted(states.begin(), states.end()));
+}
+
+TEST_CASE("StateSetTable") {
+  std::mt19937 random{1};
+  StateSetTable table{300};
+  StateSet set{300};
+  std::vector<std::vector<std::uint32_t>> added;
+  for (auto round = 0; round != 500; ++round) {
+    set.Clear();
+    std::vector<std::uint32_t> states;
+    for (auto count = random() % 40; count != 0; --count) {
+      auto state = static_cast<std::uint32_t>(random() % 300);
+      if (set.Insert(state)) {
+        states.push_back(state);
+      }
+    }
+    std::sort(states.begin(), states.end());
+    auto [id, inserted] = table.Intern(set);
+    if (inserted) {
+      CHECK(id == added.size());
+      added.push_back(states);
+    } else {
+      CHECK(added[id] == states);
+    }
+  }
+  for (std::uint32_t id = 0; id != added.size(); ++id) {
+    std::vector<std::uint32_t> states;
+    table.ForeachState(id, [&](std::uint32_t state) { states.push_back(state); });
+    CHECK(states == added[id]);
+    CHECK(table.SetSize(id) == added[id].size());
+  }
+}
+
+TEST_CASE("StateSetInsertionOrder") {
+  // small sets are kept in the order of insertion and sorted when interned
+  StateSetTable table{100000};
+  StateSet set{100000};
+  for (std::uint32_t state = 3000; state != 0; --state) {
+    set.Insert(state * 3);
+  }
+  CHECK_FALSE(set.IsDense());
+  auto [id, inserted] = table.Intern(set);
+  CHECK(inserted);
+  std::vector<std::uint32_t> states;
+  table.ForeachState(id, [&](std::uint32_t state) { states.push_back(state); });
+  CHECK(states.size() == 3000);
+  CHECK(std::is_sorted(states.begin(), states.end()));
+
+  set.Clear();
+  CHECK_FALSE(set.Contains(3));
+  for (std::uint32_t state = 1; state != 3001; ++state) {
+    set.Insert(state * 3);
+  }
+  CHECK(table.Intern(set) == std::pair{id, false});
+  set.Insert(1);
+  CHECK(table.Intern(set).second);
+}
@@ -0,0 +1,76 @@
+#include <cppformlang/finite_automata/dense_deterministic_automaton.h>
+#include <cppformlang/finite_automata/nondeterministic_finite_automaton.h>
+#include <cppformlang/finite_automata/stats.h>
+#include <doctest/doctest.h>
+
+#include <vector>
+
+using namespace cppformlang::finite_automata;
+
+namespace {
+
+std::vector<Phase> traced;
+
+void Trace(Phase phase, std::chrono::nanoseconds) { traced.push_back(phase); }
+
+std::size_t Index(Phase phase) { return static_cast<std::size_t>(phase); }
+
+}  // namespace
+
+TEST_CASE("MemoryUsageGrowsWithTheAutomaton") {
+  NondeterministicFiniteAutomaton nfa;
+  auto empty = nfa.MemoryUsage();
+  nfa.AddTransition(0, 'a', 1);
+  auto small = nfa.MemoryUsage();
+  CHECK(empty < small);
+  for (State state = 1; state != 1000; ++state) {
+    nfa.AddTransition(state, 'a' + static_cast<Symbol>(state % 3), state + 1);
+  }
+  CHECK(small < nfa.MemoryUsage());
+
+  nfa.SetStartState(0, true);
+  nfa.SetFinalState(1000, true);
+  DenseDeterministicAutomaton dfa{nfa};
+  CHECK(dfa.MemoryUsage() >= dfa.StatesCount() * dfa.SymbolsCount() * sizeof(State));
+}
+
+TEST_CASE("AlgorithmStats") {
+  ResetThreadStats();
+  SetTraceSink(Trace);
+  traced.clear();
+
+  auto nfa = NondeterministicFiniteAutomaton::FromRegex("(a|b)*+a+(a|b)+(a|b)");
+  auto dfa = nfa.ToDeterministic();
+  DenseDeterministicAutomaton dense{dfa};
+  auto minimal = dense.Minimize();
+  std::vector<Symbol> word{'b', 'a', 'b', 'a'};
+  CHECK(nfa.Accepts(word.data(), word.data() + word.size()));
+  CHECK(minimal.Accepts(word.data(), word.data() + word.size()));
+  nfa.ForeachStartState([&](State state) { CHECK(nfa.Eclose(state).size() > 1); });
+  SetTraceSink(nullptr);
+
+  const auto& stats = ThreadStats();
+  if constexpr (kStatsEnabled) {
+    CHECK(stats.subset_states == dfa.StatesCount());
+    CHECK(stats.subset_lookups >= stats.subset_states);
+    CHECK(stats.subset_probes >= stats.subset_lookups);
+    CHECK(stats.max_probe_length >= 1);
+    CHECK(stats.closures > 0);
+    CHECK(stats.max_closure_size > 1);
+    CHECK(stats.peak_bytes >= dfa.MemoryUsage());
+    CHECK(stats.phase_calls[Index(Phase::kToDeterministic)] == 1);
+    CHECK(stats.phase_calls[Index(Phase::kMinimize)] == 1);
+    CHECK(stats.phase_calls[Index(Phase::kAccepts)] == 2);
+    CHECK(traced == std::vector<Phase>{Phase::kToDeterministic, Phase::kMinimize, Phase::kAccepts, Phase::kAccepts});
+  } else {
+    CHECK(stats.subset_states == 0);
+    CHECK(stats.closures == 0);
+    CHECK(stats.peak_bytes == 0);
+    CHECK(stats.phase_calls[Index(Phase::kAccepts)] == 0);
+    CHECK(traced.empty());
+  }
+
+  ResetThreadStats();
+  CHECK(ThreadStats().subset_states == 0);
+  CHECK(ThreadStats().phase_time[Index(Phase::kMinimize)].count() == 0);
+}
@@ -0,0 +1,20 @@
+#include <words.h>
+
+namespace words {
+
+std::vector<std::vector<Symbol>> AllWords(const std::vector<Symbol>& symbols, std::size_t max_length) {
+  std::vector<std::vector<Symbol>> words{{}};
+  for (std::size_t i = 0; i != words.size(); ++i) {
+    if (words[i].size() == max_length) {
+      continue;
+    }
+    for (auto symbol : symbols) {
+      auto word = words[i];
+      word.push_back(symbol);
+      words.push_back(word);
+    }
+  }
+  return words;
+}
+
+}  // namespace words
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cppformlang/finite_automata/finite_automata.h>
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * \brief Word enumeration shared by the tests
+ */
+namespace words {
+
+using cppformlang::finite_automata::Symbol;
+
+/**
+ * \brief All words over the symbols of at most max_length symbols, shortest first
+ */
+std::vector<std::vector<Symbol>> AllWords(const std::vector<Symbol>& symbols, std::size_t max_length);
+
+}  // namespace words